@@ -0,0 +1,30 @@
+#ifndef S21_INLINE_STORAGE_H
+#define S21_INLINE_STORAGE_H
+
+#include <cstddef>
+
+namespace s21 {
+
+// Raw, suitably aligned room for N objects of T inside the owning object.
+// Used by the fixed-capacity modes of queue and stack; the N == 0
+// specialization is empty so the growable modes pay nothing for it.
+template <typename T, std::size_t N>
+class InlineStorage {
+ public:
+  T *get() noexcept { return reinterpret_cast<T *>(bytes_); }
+  const T *get() const noexcept { return reinterpret_cast<const T *>(bytes_); }
+
+ private:
+  alignas(T) unsigned char bytes_[N * sizeof(T)];
+};
+
+template <typename T>
+class InlineStorage<T, 0> {
+ public:
+  T *get() noexcept { return nullptr; }
+  const T *get() const noexcept { return nullptr; }
+};
+
+}  // namespace s21
+
+#endif  // S21_INLINE_STORAGE_H
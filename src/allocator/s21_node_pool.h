@@ -0,0 +1,226 @@
+#ifndef S21_NODE_POOL_H
+#define S21_NODE_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace s21 {
+
+// Slab allocator for the fixed-size nodes of list and BinaryTree. Memory is
+// taken from Allocator (rebound to the slot type through
+// std::allocator_traits) in slabs that double in size; freed nodes go to an
+// intrusive free list and are reused before the slab is advanced. Release()
+// returns every slab at once, so a container clear() only has to destroy its
+// values.
+//
+// Share() lets two containers hand nodes to each other (list::splice and
+// merge, BinaryTree::merge), so a node may end up on either pool's free
+// list. The slabs both pools have so far move into a new group, which
+// also keeps the groups they held before; each group is returned when the
+// last pool or group holding it lets go. A pool only ever grows into
+// slabs of its own, and a group never changes once made except for its
+// atomic reference count, so containers that once traded nodes can still
+// be used from different threads. As with std::list::splice, the two
+// allocators must compare equal.
+template <typename Node, typename Allocator = std::allocator<Node>>
+class NodePool {
+ public:
+  using allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using size_type = std::size_t;
+
+  NodePool() = default;
+  explicit NodePool(const allocator_type &alloc) : alloc_(alloc) {}
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+  ~NodePool() { Release(); }
+
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+  template <typename... Args>
+  Node *New(Args &&...args) {
+    Node *node = Allocate();
+    allocator_type alloc(alloc_);
+    try {
+      node_traits::construct(alloc, node, std::forward<Args>(args)...);
+    } catch (...) {
+      Deallocate(node);
+      throw;
+    }
+    return node;
+  }
+
+  void Delete(Node *node) {
+    Destroy(node);
+    Deallocate(node);
+  }
+
+  // Runs the destructor only; the storage comes back with Release().
+  void Destroy(Node *node) {
+    allocator_type alloc(alloc_);
+    node_traits::destroy(alloc, node);
+  }
+
+  // Makes sure the next count allocations come from one contiguous slab
+  // rather than a chain of growing ones.
+  void Reserve(size_type count) {
+    if (static_cast<size_type>(end_ - next_) < count) Grow(count + 1);
+  }
+
+  void Release() noexcept {
+    FreeSlabs(slabs_);
+    slabs_ = nullptr;
+    Unref(group_);
+    group_ = nullptr;
+    free_ = nullptr;
+    next_ = nullptr;
+    end_ = nullptr;
+    slab_size_ = kMinSlab;
+  }
+
+  void swap(NodePool &other) noexcept {
+    using std::swap;
+    swap(alloc_, other.alloc_);
+    swap(free_, other.free_);
+    swap(next_, other.next_);
+    swap(end_, other.end_);
+    swap(slabs_, other.slabs_);
+    swap(group_, other.group_);
+    swap(slab_size_, other.slab_size_);
+  }
+
+  // After this call nodes allocated by either pool may be freed into, and
+  // outlive, the other one. Pools that already share everything they have
+  // are left alone, so repeated splices between two lists are free.
+  void Share(NodePool &other) {
+    if (this == &other) return;
+    if (group_ == other.group_ && slabs_ == nullptr &&
+        other.slabs_ == nullptr) {
+      return;
+    }
+    group_allocator alloc(alloc_);
+    Group *group = group_traits::allocate(alloc, 1);
+    // Both pools hand their references to the old groups over to this one.
+    ::new (static_cast<void *>(group))
+        Group{Append(other.slabs_, slabs_), {group_, other.group_}, {2}};
+    slabs_ = other.slabs_ = nullptr;
+    group_ = other.group_ = group;
+  }
+
+ private:
+  union Slot;
+  struct SlabHeader {
+    Slot *next;
+    size_type count;
+  };
+  // The first slot of every slab is its header, the rest hold nodes. A
+  // free slot reuses the node storage as the free list link.
+  union Slot {
+    Slot *next;
+    SlabHeader header;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  struct Group {
+    Slot *slabs;
+    Group *kept[2];
+    std::atomic<size_type> refs;
+  };
+
+  using node_traits = std::allocator_traits<allocator_type>;
+  using group_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Group>;
+  using group_traits = std::allocator_traits<group_allocator>;
+  using slot_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+
+  static constexpr size_type kMinSlab = 16;
+  static constexpr size_type kMaxSlab = 4096;
+
+  Node *Allocate() {
+    Slot *slot = free_;
+    if (slot != nullptr) {
+      free_ = slot->next;
+    } else {
+      if (next_ == end_) Grow(slab_size_);
+      slot = next_++;
+    }
+    return reinterpret_cast<Node *>(slot->storage);
+  }
+
+  void Deallocate(Node *node) noexcept {
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    slot->next = free_;
+    free_ = slot;
+  }
+
+  void Grow(size_type count) {
+    Slot *slab = slot_traits::allocate(alloc_, count);
+    slab->header.count = count;
+    slab->header.next = slabs_;
+    slabs_ = slab;
+    next_ = slab + 1;
+    end_ = slab + count;
+    if (slab_size_ < kMaxSlab) slab_size_ *= 2;
+  }
+
+  // The pool or group that drops the last reference returns the slabs;
+  // the acquire-release decrement orders every earlier use of the nodes
+  // before that. A dead group waits on a stack, linked through kept[0],
+  // until kept[1] is dropped too, so a long history of shares is freed
+  // without recursion.
+  void Unref(Group *group) noexcept {
+    group_allocator alloc(alloc_);
+    Group *stack = nullptr;
+    for (;;) {
+      if (group != nullptr &&
+          group->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        FreeSlabs(group->slabs);
+        Group *next = group->kept[0];
+        group->kept[0] = stack;
+        stack = group;
+        group = next;
+      } else if (stack != nullptr) {
+        Group *done = stack;
+        stack = done->kept[0];
+        group = done->kept[1];
+        done->~Group();
+        group_traits::deallocate(alloc, done, 1);
+      } else {
+        return;
+      }
+    }
+  }
+
+  void FreeSlabs(Slot *slab) noexcept {
+    while (slab != nullptr) {
+      Slot *next = slab->header.next;
+      slot_traits::deallocate(alloc_, slab, slab->header.count);
+      slab = next;
+    }
+  }
+
+  static Slot *Append(Slot *to, Slot *slabs) noexcept {
+    if (slabs == nullptr) return to;
+    Slot *last = slabs;
+    while (last->header.next != nullptr) last = last->header.next;
+    last->header.next = to;
+    return slabs;
+  }
+
+  slot_allocator alloc_;
+  Slot *free_{nullptr};
+  Slot *next_{nullptr};
+  Slot *end_{nullptr};
+  Slot *slabs_{nullptr};
+  Group *group_{nullptr};
+  size_type slab_size_{kMinSlab};
+};
+
+}  // namespace s21
+
+#endif  // S21_NODE_POOL_H
@@ -0,0 +1,62 @@
+#ifndef S21_RELOCATE_H
+#define S21_RELOCATE_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Relocation moves elements into raw storage and ends their lifetime at the
+// source; vector, queue and stack grow through it. Trivially copyable types
+// go through memcpy; others are moved when that cannot throw (or cannot be
+// avoided) and copied otherwise, so a failed reallocation leaves the source
+// untouched.
+
+// Builds count elements at to from those at from, which stay alive. If a
+// construction throws, the elements built so far are destroyed again.
+template <typename T, typename Allocator>
+void RelocateBuild(T *from, std::size_t count, T *to, Allocator &alloc) {
+  using traits = std::allocator_traits<Allocator>;
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (count != 0) {
+      std::memcpy(static_cast<void *>(to), from, count * sizeof(T));
+    }
+  } else {
+    std::size_t i = 0;
+    try {
+      for (; i != count; ++i) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T>) {
+          traits::construct(alloc, to + i, std::move(from[i]));
+        } else {
+          traits::construct(alloc, to + i, std::as_const(from[i]));
+        }
+      }
+    } catch (...) {
+      while (i != 0) traits::destroy(alloc, to + --i);
+      throw;
+    }
+  }
+}
+
+template <typename T, typename Allocator>
+void DestroyElements(T *first, std::size_t count, Allocator &alloc) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (std::size_t i = 0; i != count; ++i) {
+      std::allocator_traits<Allocator>::destroy(alloc, first + i);
+    }
+  }
+}
+
+template <typename T, typename Allocator>
+void Relocate(T *from, std::size_t count, T *to, Allocator &alloc) {
+  RelocateBuild(from, count, to, alloc);
+  DestroyElements(from, count, alloc);
+}
+
+}  // namespace s21
+
+#endif  // S21_RELOCATE_H
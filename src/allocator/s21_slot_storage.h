@@ -0,0 +1,112 @@
+#ifndef S21_SLOT_STORAGE_H
+#define S21_SLOT_STORAGE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "s21_inline_storage.h"
+#include "s21_relocate.h"
+
+namespace s21 {
+
+// The element slots of queue and stack; the owner builds and destroys the
+// elements. A non-zero Capacity is only the inline slots, so a fixed
+// container carries no pointer or capacity it would never use.
+template <typename T, std::size_t Capacity>
+class SlotStorage {
+ public:
+  T *get() noexcept { return slots_.get(); }
+  const T *get() const noexcept { return slots_.get(); }
+  static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+ private:
+  InlineStorage<T, Capacity> slots_;
+};
+
+// Capacity == 0: a heap block that doubles when full and never shrinks.
+template <typename T>
+class SlotStorage<T, 0> {
+ public:
+  using size_type = std::size_t;
+
+  SlotStorage() noexcept = default;
+  SlotStorage(const SlotStorage &) = delete;
+  SlotStorage &operator=(const SlotStorage &) = delete;
+  ~SlotStorage() { Release(); }
+
+  T *get() noexcept { return block_; }
+  const T *get() const noexcept { return block_; }
+  size_type capacity() const noexcept { return capacity_; }
+
+  // Moves the size elements of the ring that starts at slot head (0 when
+  // they are not a ring) to the front of a block twice as big and builds
+  // one more after them from args. The new element comes first, so args
+  // may refer to an element being moved.
+  template <typename... Args>
+  void Grow(size_type head, size_type size, Args &&...args) {
+    MoveTo<true>(capacity_ != 0 ? capacity_ * 2 : kMinCapacity, head, size,
+                 std::forward<Args>(args)...);
+  }
+
+  // Makes room for capacity elements; the size live ones are at the front.
+  void Reserve(size_type capacity, size_type size) {
+    if (capacity > capacity_) MoveTo<false>(capacity, 0, size);
+  }
+
+  // Frees the block, whose elements must already be destroyed.
+  void Release() noexcept {
+    if (block_ != nullptr) std::allocator<T>().deallocate(block_, capacity_);
+    block_ = nullptr;
+    capacity_ = 0;
+  }
+
+  void swap(SlotStorage &other) noexcept {
+    std::swap(block_, other.block_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+ private:
+  static constexpr size_type kMinCapacity = 8;
+
+  template <bool kEmplace, typename... Args>
+  void MoveTo(size_type new_capacity, size_type head, size_type size,
+              Args &&...args) {
+    std::allocator<T> alloc;
+    T *block = alloc.allocate(new_capacity);
+    size_type first = std::min(size, capacity_ - head);
+    size_type moved = 0;
+    try {
+      if constexpr (kEmplace) {
+        ::new (static_cast<void *>(block + size))
+            T(std::forward<Args>(args)...);
+      }
+      try {
+        RelocateBuild(block_ + head, first, block, alloc);
+        moved = first;
+        RelocateBuild(block_, size - first, block + first, alloc);
+      } catch (...) {
+        DestroyElements(block, moved, alloc);
+        if constexpr (kEmplace) block[size].~T();
+        throw;
+      }
+    } catch (...) {
+      alloc.deallocate(block, new_capacity);
+      throw;
+    }
+    DestroyElements(block_ + head, first, alloc);
+    DestroyElements(block_, size - first, alloc);
+    Release();
+    block_ = block;
+    capacity_ = new_capacity;
+  }
+
+  T *block_{nullptr};
+  size_type capacity_{0};
+};
+
+}  // namespace s21
+
+#endif  // S21_SLOT_STORAGE_H
@@ -0,0 +1,193 @@
+// Concurrent containers against std containers behind a std::mutex. Every
+// key passes from the producer threads to the consumer threads; starting
+// and joining the threads is part of the measured time. The work-stealing
+// cases scale the thread count up to the cores of the machine, so compare
+// them across runs on the same machine.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "s21_bench.h"
+
+namespace {
+
+using s21::bench::DoNotOptimize;
+using s21::bench::Keys;
+using s21::bench::Time;
+
+// std::queue under one lock, with the interface of concurrent_queue. A
+// batch takes the lock once.
+class LockedQueue {
+ public:
+  explicit LockedQueue(std::size_t capacity) : capacity_(capacity) {}
+  bool try_push(int value) { return try_push_batch(&value, &value + 1) != 0; }
+  std::size_t try_push_batch(const int *first, const int *last) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t count = 0;
+    for (; first != last && queue_.size() != capacity_; ++first, ++count) {
+      queue_.push(*first);
+    }
+    return count;
+  }
+  std::size_t try_pop_batch(int *out, std::size_t max) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t count = 0;
+    for (; count != max && !queue_.empty(); ++count) {
+      out[count] = queue_.front();
+      queue_.pop();
+    }
+    return count;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::queue<int> queue_;
+  std::size_t capacity_;
+};
+
+// std::deque under one lock, with the interface of work_stealing_deque.
+class LockedDeque {
+ public:
+  void push(int value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    deque_.push_back(value);
+  }
+  bool try_pop(int &out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deque_.empty()) return false;
+    out = deque_.back();
+    deque_.pop_back();
+    return true;
+  }
+  bool try_steal(int &out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deque_.empty()) return false;
+    out = deque_.front();
+    deque_.pop_front();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::deque<int> deque_;
+};
+
+// Half the cores produce and half consume, at least one of each.
+std::size_t Pairs() {
+  return std::max<std::size_t>(1, std::thread::hardware_concurrency() / 2);
+}
+
+template <typename Q, std::size_t Batch, bool kManyThreads>
+double Transfer(const Keys &keys) {
+  std::size_t pairs = kManyThreads ? Pairs() : 1;
+  Q queue(1024);
+  std::atomic<std::size_t> received{0};
+  std::atomic<long> total{0};
+  return Time([&] {
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p != pairs; ++p) {
+      threads.emplace_back([&, p] {
+        std::size_t begin = keys.size() * p / pairs;
+        std::size_t end = keys.size() * (p + 1) / pairs;
+        while (begin != end) {
+          std::size_t last = std::min(end, begin + Batch);
+          std::size_t pushed =
+              queue.try_push_batch(keys.data() + begin, keys.data() + last);
+          if (pushed == 0) std::this_thread::yield();
+          begin += pushed;
+        }
+      });
+    }
+    for (std::size_t c = 0; c != pairs; ++c) {
+      threads.emplace_back([&] {
+        int values[Batch];
+        long sum = 0;
+        while (received.load(std::memory_order_relaxed) != keys.size()) {
+          std::size_t popped = queue.try_pop_batch(values, Batch);
+          if (popped == 0) std::this_thread::yield();
+          for (std::size_t i = 0; i != popped; ++i) sum += values[i];
+          received.fetch_add(popped, std::memory_order_relaxed);
+        }
+        total.fetch_add(sum, std::memory_order_relaxed);
+      });
+    }
+    for (auto &thread : threads) thread.join();
+    DoNotOptimize(total.load());
+  });
+}
+
+// A scheduler's loop: the owner spawns every key as a task and runs every
+// other one itself, while the other threads - 1 threads steal. Once the
+// owner finds its deque empty, no task is left anywhere.
+template <typename D>
+double Schedule(const Keys &keys, std::size_t threads) {
+  D tasks;
+  std::atomic<bool> stop{false};
+  std::atomic<long> total{0};
+  return Time([&] {
+    std::vector<std::thread> thieves;
+    for (std::size_t t = 1; t < threads; ++t) {
+      thieves.emplace_back([&] {
+        long sum = 0;
+        int task;
+        while (!stop.load(std::memory_order_relaxed)) {
+          if (tasks.try_steal(task)) {
+            sum += task;
+          } else {
+            std::this_thread::yield();
+          }
+        }
+        total.fetch_add(sum, std::memory_order_relaxed);
+      });
+    }
+    long sum = 0;
+    int task;
+    for (std::size_t i = 0; i != keys.size(); ++i) {
+      tasks.push(keys[i]);
+      if (i % 2 == 1 && tasks.try_pop(task)) sum += task;
+    }
+    while (tasks.try_pop(task)) sum += task;
+    stop.store(true, std::memory_order_relaxed);
+    for (auto &thief : thieves) thief.join();
+    total.fetch_add(sum, std::memory_order_relaxed);
+    DoNotOptimize(total.load());
+  });
+}
+
+using Queue = s21::concurrent_queue<int>;
+using Deque = s21::work_stealing_deque<int>;
+
+S21_BENCHMARK("concurrent_queue", "spsc", (Transfer<Queue, 1, false>),
+              (Transfer<LockedQueue, 1, false>));
+S21_BENCHMARK("concurrent_queue", "mpmc", (Transfer<Queue, 1, true>),
+              (Transfer<LockedQueue, 1, true>));
+S21_BENCHMARK("concurrent_queue", "mpmc/16", (Transfer<Queue, 16, true>),
+              (Transfer<LockedQueue, 16, true>));
+
+// tasks/N for N doubling from 1 up to the hardware thread count, which is
+// always the last one.
+const bool kScheduleRegistered = [] {
+  std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+  for (std::size_t threads = 1;; threads = std::min(2 * threads, cores)) {
+    s21::bench::Registrar(
+        "work_stealing", "tasks/" + std::to_string(threads),
+        [threads](const Keys &keys) {
+          return Schedule<Deque>(keys, threads);
+        },
+        [threads](const Keys &keys) {
+          return Schedule<LockedDeque>(keys, threads);
+        });
+    if (threads == cores) break;
+  }
+  return true;
+}();
+
+}  // namespace
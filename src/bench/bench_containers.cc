@@ -0,0 +1,550 @@
+// s21 containers against their std counterparts. Every run gets a
+// permutation of 0..n-1 in the order under test; anything built before the
+// measured section is not timed.
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <map>
+#include <queue>
+#include <set>
+#include <stack>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "s21_bench.h"
+
+namespace {
+
+using s21::bench::DoNotOptimize;
+using s21::bench::Keys;
+using s21::bench::Time;
+
+template <typename C>
+typename C::value_type Element(int key) {
+  if constexpr (std::is_arithmetic_v<typename C::value_type>) {
+    return key;
+  } else {
+    return {key, key};
+  }
+}
+
+template <typename V>
+long KeyOf(const V &value) {
+  if constexpr (std::is_arithmetic_v<V>) {
+    return value;
+  } else {
+    return value.first;
+  }
+}
+
+using List = s21::list<int>;
+using StdList = std::list<int>;
+using UnrolledList = s21::unrolled_list<int>;
+using Vector = s21::vector<int>;
+using StdVector = std::vector<int>;
+using Set = s21::set<int>;
+using StdSet = std::set<int>;
+using Multiset = s21::multiset<int>;
+using StdMultiset = std::multiset<int>;
+using Map = s21::map<int, int>;
+using StdMap = std::map<int, int>;
+using BtreeSet = s21::btree_set<int>;
+using BtreeMap = s21::btree_map<int, int>;
+using FlatSet = s21::flat_set<int>;
+using FlatMap = s21::flat_map<int, int>;
+using UnorderedSet = s21::unordered_set<int>;
+using StdUnorderedSet = std::unordered_set<int>;
+using UnorderedMap = s21::unordered_map<int, int>;
+using StdUnorderedMap = std::unordered_map<int, int>;
+using UnorderedMap64 = s21::unordered_map<long, long>;
+using StdUnorderedMap64 = std::unordered_map<long, long>;
+
+// Sequence containers
+
+template <typename C>
+double PushBack(const Keys &keys) {
+  C c;
+  return Time([&] {
+    for (int key : keys) c.push_back(key);
+    DoNotOptimize(c.size());
+  });
+}
+
+template <typename C>
+double IterateSequence(const Keys &keys) {
+  C c;
+  for (int key : keys) c.push_back(key);
+  return Time([&] {
+    long sum = 0;
+    for (auto it = c.begin(); it != c.end(); ++it) sum += *it;
+    DoNotOptimize(sum);
+  });
+}
+
+template <typename C>
+double PopFront(const Keys &keys) {
+  C c;
+  for (int key : keys) c.push_back(key);
+  return Time([&] {
+    long sum = 0;
+    for (; !c.empty(); c.pop_front()) sum += c.front();
+    DoNotOptimize(sum);
+  });
+}
+
+template <typename C>
+double PopBack(const Keys &keys) {
+  C c;
+  for (int key : keys) c.push_back(key);
+  return Time([&] {
+    long sum = 0;
+    for (; !c.empty(); c.pop_back()) sum += c.back();
+    DoNotOptimize(sum);
+  });
+}
+
+template <typename C>
+double ListSort(const Keys &keys) {
+  C c;
+  for (int key : keys) c.push_back(key);
+  return Time([&] {
+    c.sort();
+    DoNotOptimize(c.front());
+  });
+}
+
+// Long strings make every copy of a value expensive, so a sort that
+// relinks nodes shows up against one that moves payloads.
+template <typename C>
+double ListSortStrings(const Keys &keys) {
+  C c;
+  for (int key : keys) c.push_back(std::string(32, 'x') + std::to_string(key));
+  return Time([&] {
+    c.sort();
+    DoNotOptimize(c.front());
+  });
+}
+
+template <typename C>
+double VectorSort(const Keys &keys) {
+  C c;
+  for (int key : keys) c.push_back(key);
+  return Time([&] {
+    std::sort(c.begin(), c.end());
+    DoNotOptimize(c.front());
+  });
+}
+
+// Merges the sorted halves of the input, so sorted and reverse keys give
+// disjoint runs and random keys interleave.
+template <typename C>
+double ListMerge(const Keys &keys) {
+  std::size_t half = keys.size() / 2;
+  Keys a(keys.begin(), keys.begin() + half), b(keys.begin() + half, keys.end());
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  C first, second;
+  for (int key : a) first.push_back(key);
+  for (int key : b) second.push_back(key);
+  return Time([&] {
+    first.merge(second);
+    DoNotOptimize(first.size());
+  });
+}
+
+// Appends the keys eight at a time: s21::list links each group as one
+// chain, std::list inserts it from an initializer_list.
+template <typename C>
+double AppendMany(const Keys &keys) {
+  C c;
+  return Time([&] {
+    std::size_t i = 0;
+    for (; i + 8 <= keys.size(); i += 8) {
+      const int *k = &keys[i];
+      if constexpr (std::is_same_v<C, List>) {
+        c.insert_many_back(k[0], k[1], k[2], k[3], k[4], k[5], k[6], k[7]);
+      } else {
+        c.insert(c.end(), {k[0], k[1], k[2], k[3], k[4], k[5], k[6], k[7]});
+      }
+    }
+    for (; i < keys.size(); ++i) c.push_back(keys[i]);
+    DoNotOptimize(c.size());
+  });
+}
+
+// Keys divided by four, so sorted keys come in runs of four equal values
+// and random keys leave few adjacent duplicates.
+template <typename C>
+double ListUnique(const Keys &keys) {
+  C c;
+  for (int key : keys) c.push_back(key / 4);
+  return Time([&] {
+    c.unique();
+    DoNotOptimize(c.size());
+  });
+}
+
+// Associative containers
+
+// Flat containers are built with one sort; a million inserts one by one
+// would each shift the array.
+template <typename C>
+constexpr bool kBuildInBulk = false;
+template <>
+constexpr bool kBuildInBulk<FlatSet> = true;
+template <>
+constexpr bool kBuildInBulk<FlatMap> = true;
+
+template <typename C>
+C Build(const Keys &keys) {
+  if constexpr (kBuildInBulk<C>) {
+    std::vector<typename C::value_type> values;
+    for (int key : keys) values.push_back(Element<C>(key));
+    return C(values.begin(), values.end());
+  } else {
+    C c;
+    for (int key : keys) c.insert(Element<C>(key));
+    return c;
+  }
+}
+
+template <typename C>
+double Insert(const Keys &keys) {
+  C c;
+  return Time([&] {
+    for (int key : keys) c.insert(Element<C>(key));
+    DoNotOptimize(c.size());
+  });
+}
+
+// Inserts the keys in batches of Batch with one range insert each.
+template <typename C, std::size_t Batch>
+double BatchInsert(const Keys &keys) {
+  C c;
+  return Time([&] {
+    for (std::size_t i = 0; i < keys.size(); i += Batch) {
+      c.insert(keys.begin() + i, keys.begin() + std::min(i + Batch,
+                                                         keys.size()));
+    }
+    DoNotOptimize(c.size());
+  });
+}
+
+template <typename C>
+double RangeBuild(const Keys &keys) {
+  return Time([&] {
+    C c(keys.begin(), keys.end());
+    DoNotOptimize(c.size());
+  });
+}
+
+template <typename C>
+double Find(const Keys &keys) {
+  C c = Build<C>(keys);
+  return Time([&] {
+    long sum = 0;
+    for (int key : keys) sum += KeyOf(*c.find(key));
+    DoNotOptimize(sum);
+  });
+}
+
+// Keys share a 32-byte prefix, so a comparison that took its strings by
+// value would copy two of them every time.
+template <typename C>
+double FindStrings(const Keys &keys) {
+  std::vector<std::string> names;
+  for (int key : keys) {
+    names.push_back(std::string(32, 'x') + std::to_string(key));
+  }
+  C c(names.begin(), names.end());
+  return Time([&] {
+    std::size_t found = 0;
+    for (const auto &name : names) found += c.count(name);
+    DoNotOptimize(found);
+  });
+}
+
+template <typename C>
+double Erase(const Keys &keys) {
+  C c = Build<C>(keys);
+  return Time([&] {
+    for (int key : keys) c.erase(c.find(key));
+    DoNotOptimize(c.size());
+  });
+}
+
+template <typename C>
+double Iterate(const Keys &keys) {
+  C c = Build<C>(keys);
+  return Time([&] {
+    long sum = 0;
+    for (auto it = c.begin(); it != c.end(); ++it) sum += KeyOf(*it);
+    DoNotOptimize(sum);
+  });
+}
+
+template <typename C>
+double Merge(const Keys &keys) {
+  std::size_t half = keys.size() / 2;
+  C first = Build<C>(Keys(keys.begin(), keys.begin() + half));
+  C second = Build<C>(Keys(keys.begin() + half, keys.end()));
+  return Time([&] {
+    first.merge(second);
+    DoNotOptimize(first.size());
+  });
+}
+
+// Union of the two halves of the input. std has no tree-level set
+// algebra, so its side runs std::set_union into an inserter.
+template <std::size_t Threads>
+double S21Union(const Keys &keys) {
+  std::size_t half = keys.size() / 2;
+  Set first(keys.begin(), keys.begin() + half);
+  Set second(keys.begin() + half, keys.end());
+  return Time([&] {
+    Set result = set_union(first, second, Threads);
+    DoNotOptimize(result.size());
+  });
+}
+
+double StdUnion(const Keys &keys) {
+  std::size_t half = keys.size() / 2;
+  StdSet first(keys.begin(), keys.begin() + half);
+  StdSet second(keys.begin() + half, keys.end());
+  return Time([&] {
+    StdSet result;
+    std::set_union(first.begin(), first.end(), second.begin(), second.end(),
+                   std::inserter(result, result.end()));
+    DoNotOptimize(result.size());
+  });
+}
+
+// Adaptors
+
+template <typename C>
+double Push(const Keys &keys) {
+  C c;
+  return Time([&] {
+    for (int key : keys) c.push(key);
+    DoNotOptimize(c.size());
+  });
+}
+
+template <typename C>
+double PopQueue(const Keys &keys) {
+  C c;
+  for (int key : keys) c.push(key);
+  return Time([&] {
+    long sum = 0;
+    for (; !c.empty(); c.pop()) sum += c.front();
+    DoNotOptimize(sum);
+  });
+}
+
+template <typename C>
+double PopStack(const Keys &keys) {
+  C c;
+  for (int key : keys) c.push(key);
+  return Time([&] {
+    long sum = 0;
+    for (; !c.empty(); c.pop()) sum += c.top();
+    DoNotOptimize(sum);
+  });
+}
+
+// Intrusive containers
+
+// An object that lives in a pool. The intrusive side links the pooled
+// objects themselves; the other side copies them into its own nodes.
+struct Pooled : s21::list_hook<>, s21::set_hook<> {
+  explicit Pooled(int key = 0) : key(key) {}
+  bool operator<(const Pooled &other) const { return key < other.key; }
+  bool operator==(const Pooled &other) const { return key == other.key; }
+  int key;
+  char payload[48] = {};
+};
+
+using Pool = std::vector<Pooled>;
+
+template <typename C>
+double PoolPushBack(const Keys &keys) {
+  Pool pool(keys.begin(), keys.end());
+  C c;
+  return Time([&] {
+    for (Pooled &item : pool) c.push_back(item);
+    DoNotOptimize(c.size());
+  });
+}
+
+template <typename C>
+double PoolPopFront(const Keys &keys) {
+  Pool pool(keys.begin(), keys.end());
+  C c;
+  for (Pooled &item : pool) c.push_back(item);
+  return Time([&] {
+    long sum = 0;
+    for (; !c.empty(); c.pop_front()) sum += c.front().key;
+    DoNotOptimize(sum);
+  });
+}
+
+template <typename C>
+double PoolInsert(const Keys &keys) {
+  Pool pool(keys.begin(), keys.end());
+  C c;
+  return Time([&] {
+    for (Pooled &item : pool) c.insert(item);
+    DoNotOptimize(c.size());
+  });
+}
+
+template <typename C>
+double PoolErase(const Keys &keys) {
+  Pool pool(keys.begin(), keys.end());
+  C c;
+  for (Pooled &item : pool) c.insert(item);
+  return Time([&] {
+    for (const Pooled &item : pool) c.erase(c.find(item));
+    DoNotOptimize(c.size());
+  });
+}
+
+using IntrusiveList = s21::intrusive_list<Pooled>;
+using IntrusiveSet = s21::intrusive_set<Pooled>;
+
+S21_BENCHMARK("list", "insert", PushBack<List>, PushBack<StdList>);
+S21_BENCHMARK("list", "erase", PopFront<List>, PopFront<StdList>);
+S21_BENCHMARK("list", "iterate", IterateSequence<List>,
+              IterateSequence<StdList>);
+S21_BENCHMARK("list", "sort", ListSort<List>, ListSort<StdList>);
+S21_BENCHMARK("list<string>", "sort", ListSortStrings<s21::list<std::string>>,
+              ListSortStrings<std::list<std::string>>);
+S21_BENCHMARK("list", "merge", ListMerge<List>, ListMerge<StdList>);
+S21_BENCHMARK("list", "unique", ListUnique<List>, ListUnique<StdList>);
+S21_BENCHMARK("list", "insert_many", AppendMany<List>, AppendMany<StdList>);
+// Against the node-per-value s21::list, in the std column: what packing
+// values into chunks gains.
+S21_BENCHMARK("unrolled_list", "insert", PushBack<UnrolledList>,
+              PushBack<List>);
+S21_BENCHMARK("unrolled_list", "erase", PopFront<UnrolledList>,
+              PopFront<List>);
+S21_BENCHMARK("unrolled_list", "iterate", IterateSequence<UnrolledList>,
+              IterateSequence<List>);
+S21_BENCHMARK("unrolled_list", "sort", ListSort<UnrolledList>,
+              ListSort<List>);
+S21_BENCHMARK("unrolled_list", "unique", ListUnique<UnrolledList>,
+              ListUnique<List>);
+S21_BENCHMARK("unrolled_list", "merge", ListMerge<UnrolledList>,
+              ListMerge<List>);
+
+S21_BENCHMARK("vector", "insert", PushBack<Vector>, PushBack<StdVector>);
+S21_BENCHMARK("vector", "erase", PopBack<Vector>, PopBack<StdVector>);
+S21_BENCHMARK("vector", "iterate", IterateSequence<Vector>,
+              IterateSequence<StdVector>);
+S21_BENCHMARK("vector", "sort", VectorSort<Vector>, VectorSort<StdVector>);
+
+S21_BENCHMARK("set", "insert", Insert<Set>, Insert<StdSet>);
+S21_BENCHMARK("set", "insert/1k", (BatchInsert<Set, 1000>),
+              (BatchInsert<StdSet, 1000>));
+S21_BENCHMARK("set", "build", RangeBuild<Set>, RangeBuild<StdSet>);
+S21_BENCHMARK("set", "find", Find<Set>, Find<StdSet>);
+S21_BENCHMARK("set", "erase", Erase<Set>, Erase<StdSet>);
+S21_BENCHMARK("set", "iterate", Iterate<Set>, Iterate<StdSet>);
+S21_BENCHMARK("set", "merge", Merge<Set>, Merge<StdSet>);
+S21_BENCHMARK("set<string>", "find", FindStrings<s21::set<std::string>>,
+              FindStrings<std::set<std::string>>);
+S21_BENCHMARK("set", "union", S21Union<1>, StdUnion);
+S21_BENCHMARK("set", "union/par", S21Union<0>, StdUnion);
+
+S21_BENCHMARK("multiset", "insert", Insert<Multiset>, Insert<StdMultiset>);
+S21_BENCHMARK("multiset", "insert/1k", (BatchInsert<Multiset, 1000>),
+              (BatchInsert<StdMultiset, 1000>));
+S21_BENCHMARK("multiset", "build", RangeBuild<Multiset>,
+              RangeBuild<StdMultiset>);
+S21_BENCHMARK("multiset", "find", Find<Multiset>, Find<StdMultiset>);
+S21_BENCHMARK("multiset", "erase", Erase<Multiset>, Erase<StdMultiset>);
+S21_BENCHMARK("multiset", "iterate", Iterate<Multiset>,
+              Iterate<StdMultiset>);
+S21_BENCHMARK("multiset", "merge", Merge<Multiset>, Merge<StdMultiset>);
+
+S21_BENCHMARK("map", "insert", Insert<Map>, Insert<StdMap>);
+S21_BENCHMARK("map", "find", Find<Map>, Find<StdMap>);
+S21_BENCHMARK("map", "erase", Erase<Map>, Erase<StdMap>);
+S21_BENCHMARK("map", "iterate", Iterate<Map>, Iterate<StdMap>);
+S21_BENCHMARK("map", "merge", Merge<Map>, Merge<StdMap>);
+
+S21_BENCHMARK("btree_set", "insert", Insert<BtreeSet>, Insert<StdSet>);
+S21_BENCHMARK("btree_set", "build", RangeBuild<BtreeSet>, RangeBuild<StdSet>);
+S21_BENCHMARK("btree_set", "find", Find<BtreeSet>, Find<StdSet>);
+S21_BENCHMARK("btree_set", "erase", Erase<BtreeSet>, Erase<StdSet>);
+S21_BENCHMARK("btree_set", "iterate", Iterate<BtreeSet>, Iterate<StdSet>);
+S21_BENCHMARK("btree_set", "merge", Merge<BtreeSet>, Merge<StdSet>);
+
+S21_BENCHMARK("flat_set", "insert", Insert<FlatSet>, Insert<StdSet>);
+S21_BENCHMARK("flat_set", "insert/1k", (BatchInsert<FlatSet, 1000>),
+              (BatchInsert<StdSet, 1000>));
+S21_BENCHMARK("flat_set", "build", RangeBuild<FlatSet>, RangeBuild<StdSet>);
+S21_BENCHMARK("flat_set", "find", Find<FlatSet>, Find<StdSet>);
+S21_BENCHMARK("flat_set", "erase", Erase<FlatSet>, Erase<StdSet>);
+S21_BENCHMARK("flat_set", "iterate", Iterate<FlatSet>, Iterate<StdSet>);
+S21_BENCHMARK("flat_set", "merge", Merge<FlatSet>, Merge<StdSet>);
+// Against btree_set, in the std column: the other cache-friendly set.
+S21_BENCHMARK("flat/btree_set", "find", Find<FlatSet>, Find<BtreeSet>);
+S21_BENCHMARK("flat_map", "find", Find<FlatMap>, Find<StdMap>);
+S21_BENCHMARK("flat_map", "iterate", Iterate<FlatMap>, Iterate<StdMap>);
+
+S21_BENCHMARK("btree_map", "insert", Insert<BtreeMap>, Insert<StdMap>);
+S21_BENCHMARK("btree_map", "find", Find<BtreeMap>, Find<StdMap>);
+S21_BENCHMARK("btree_map", "erase", Erase<BtreeMap>, Erase<StdMap>);
+S21_BENCHMARK("btree_map", "iterate", Iterate<BtreeMap>, Iterate<StdMap>);
+
+S21_BENCHMARK("unordered_set", "insert", Insert<UnorderedSet>,
+              Insert<StdUnorderedSet>);
+S21_BENCHMARK("unordered_set", "find", Find<UnorderedSet>,
+              Find<StdUnorderedSet>);
+S21_BENCHMARK("unordered_set", "erase", Erase<UnorderedSet>,
+              Erase<StdUnorderedSet>);
+S21_BENCHMARK("unordered_set", "iterate", Iterate<UnorderedSet>,
+              Iterate<StdUnorderedSet>);
+// Against s21::list and s21::set of copies, in the std column: what
+// linking pooled objects in place saves.
+S21_BENCHMARK("intrusive_list", "insert", PoolPushBack<IntrusiveList>,
+              PoolPushBack<s21::list<Pooled>>);
+S21_BENCHMARK("intrusive_list", "erase", PoolPopFront<IntrusiveList>,
+              PoolPopFront<s21::list<Pooled>>);
+S21_BENCHMARK("intrusive_set", "insert", PoolInsert<IntrusiveSet>,
+              PoolInsert<s21::set<Pooled>>);
+S21_BENCHMARK("intrusive_set", "erase", PoolErase<IntrusiveSet>,
+              PoolErase<s21::set<Pooled>>);
+
+// Against the ordered s21::set, in the std column: what a lookup that
+// does not need order gains from hashing.
+S21_BENCHMARK("unordered/set", "insert", Insert<UnorderedSet>, Insert<Set>);
+S21_BENCHMARK("unordered/set", "find", Find<UnorderedSet>, Find<Set>);
+
+S21_BENCHMARK("unordered_map", "insert", Insert<UnorderedMap>,
+              Insert<StdUnorderedMap>);
+S21_BENCHMARK("unordered_map", "find", Find<UnorderedMap>,
+              Find<StdUnorderedMap>);
+S21_BENCHMARK("unordered_map", "erase", Erase<UnorderedMap>,
+              Erase<StdUnorderedMap>);
+S21_BENCHMARK("unordered_map", "iterate", Iterate<UnorderedMap>,
+              Iterate<StdUnorderedMap>);
+S21_BENCHMARK("unordered_map64", "insert", Insert<UnorderedMap64>,
+              Insert<StdUnorderedMap64>);
+S21_BENCHMARK("unordered_map64", "find", Find<UnorderedMap64>,
+              Find<StdUnorderedMap64>);
+
+S21_BENCHMARK("queue", "insert", Push<s21::queue<int>>, Push<std::queue<int>>);
+S21_BENCHMARK("queue", "erase", PopQueue<s21::queue<int>>,
+              PopQueue<std::queue<int>>);
+S21_BENCHMARK("stack", "insert", Push<s21::stack<int>>, Push<std::stack<int>>);
+S21_BENCHMARK("stack", "erase", PopStack<s21::stack<int>>,
+              PopStack<std::stack<int>>);
+
+}  // namespace
@@ -0,0 +1,183 @@
+// Runs every registered benchmark over sorted, reverse and random keys at
+// sizes growing tenfold from --min to --max, prints a table to stdout and
+// optionally writes the same results as JSON.
+//
+//   ./bench_runner [--min N] [--max N] [--filter text] [--budget seconds]
+//                  [--json path]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "s21_bench.h"
+
+namespace {
+
+using s21::bench::Keys;
+using s21::bench::Order;
+
+struct Options {
+  std::size_t min_size = 1000;
+  std::size_t max_size = 10000000;
+  double budget = 3.0;
+  std::string filter;
+  std::string json;
+};
+
+struct Result {
+  std::string container;
+  std::string op;
+  Order order;
+  std::size_t n;
+  double s21_ns;  // per element, negative when skipped
+  double std_ns;
+};
+
+// Small inputs are repeated until they add up to a measurable time; the
+// best run is reported.
+constexpr double kMinTotal = 0.05;
+constexpr int kMaxRuns = 20;
+
+double Measure(const s21::bench::Run &run, const Keys &keys) {
+  double best = run(keys);
+  double total = best;
+  for (int i = 1; i < kMaxRuns && total < kMinTotal; ++i) {
+    double t = run(keys);
+    total += t;
+    if (t < best) best = t;
+  }
+  return best;
+}
+
+// Skips sizes whose run is expected to exceed the budget, extrapolating
+// from the growth between the last two sizes so that quadratic cases stop
+// early while n log n ones keep going.
+class Series {
+ public:
+  explicit Series(double budget) : budget_(budget) {}
+  bool Skip() const {
+    if (last_ < 0) return false;
+    double growth = prev_ > 0 ? last_ / prev_ : 10.0;
+    if (growth < 10.0) growth = 10.0;
+    return last_ * growth > budget_;
+  }
+  double Run(const s21::bench::Run &run, const Keys &keys) {
+    if (Skip()) return -1;
+    prev_ = last_;
+    last_ = Measure(run, keys);
+    return last_;
+  }
+
+ private:
+  double budget_;
+  double prev_ = -1;
+  double last_ = -1;
+};
+
+std::size_t ParseSize(const char *text) {
+  return static_cast<std::size_t>(std::strtod(text, nullptr));
+}
+
+Options ParseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!std::strcmp(argv[i], "--min")) {
+      options.min_size = ParseSize(argv[i + 1]);
+    } else if (!std::strcmp(argv[i], "--max")) {
+      options.max_size = ParseSize(argv[i + 1]);
+    } else if (!std::strcmp(argv[i], "--budget")) {
+      options.budget = std::strtod(argv[i + 1], nullptr);
+    } else if (!std::strcmp(argv[i], "--filter")) {
+      options.filter = argv[i + 1];
+    } else if (!std::strcmp(argv[i], "--json")) {
+      options.json = argv[i + 1];
+    } else {
+      std::cerr << "unknown option " << argv[i] << '\n';
+      std::exit(1);
+    }
+  }
+  if (options.min_size == 0) options.min_size = 1;
+  return options;
+}
+
+void PrintCell(double ns) {
+  if (ns < 0) {
+    std::printf(" %10s", "skipped");
+  } else {
+    std::printf(" %10.2f", ns);
+  }
+}
+
+void PrintRow(const Result &r) {
+  std::printf("%-14s %-10s %-8s %9zu", r.container.c_str(), r.op.c_str(),
+              s21::bench::OrderName(r.order), r.n);
+  PrintCell(r.s21_ns);
+  PrintCell(r.std_ns);
+  if (r.s21_ns > 0 && r.std_ns > 0) {
+    std::printf(" %7.2fx\n", r.s21_ns / r.std_ns);
+  } else {
+    std::printf(" %8s\n", "-");
+  }
+  std::fflush(stdout);
+}
+
+void WriteJsonNumber(std::ostream &out, double ns) {
+  if (ns < 0) {
+    out << "null";
+  } else {
+    out << ns;
+  }
+}
+
+void WriteJson(const std::string &path, const std::vector<Result> &results) {
+  std::ofstream out(path);
+  out << "[\n";
+  for (std::size_t i = 0; i != results.size(); ++i) {
+    const Result &r = results[i];
+    out << "  {\"container\": \"" << r.container << "\", \"op\": \"" << r.op
+        << "\", \"order\": \"" << s21::bench::OrderName(r.order)
+        << "\", \"n\": " << r.n << ", \"s21_ns\": ";
+    WriteJsonNumber(out, r.s21_ns);
+    out << ", \"std_ns\": ";
+    WriteJsonNumber(out, r.std_ns);
+    out << (i + 1 != results.size() ? "},\n" : "}\n");
+  }
+  out << "]\n";
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options options = ParseOptions(argc, argv);
+  std::vector<Result> results;
+
+  std::printf("%-14s %-10s %-8s %9s %10s %10s %8s\n", "container", "op",
+              "order", "n", "s21 ns/el", "std ns/el", "s21/std");
+  for (const auto &benchmark : s21::bench::Registry()) {
+    std::string name = benchmark.container + "/" + benchmark.op;
+    if (name.find(options.filter) == std::string::npos) continue;
+    for (Order order : {Order::kSorted, Order::kReverse, Order::kRandom}) {
+      Series s21_series(options.budget), std_series(options.budget);
+      for (std::size_t n = options.min_size; n <= options.max_size; n *= 10) {
+        if (s21_series.Skip() && std_series.Skip()) break;
+        Keys keys = s21::bench::MakeKeys(n, order);
+        double s21_time = s21_series.Run(benchmark.s21, keys);
+        double std_time = std_series.Run(benchmark.std, keys);
+        double scale = 1e9 / static_cast<double>(n);
+        Result result{benchmark.container, benchmark.op,
+                      order,               n,
+                      s21_time < 0 ? -1 : s21_time * scale,
+                      std_time < 0 ? -1 : std_time * scale};
+        PrintRow(result);
+        results.push_back(result);
+      }
+    }
+  }
+
+  if (!options.json.empty()) WriteJson(options.json, results);
+  return 0;
+}
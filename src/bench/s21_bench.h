@@ -0,0 +1,96 @@
+#ifndef S21_BENCH_H
+#define S21_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+namespace bench {
+
+using Keys = std::vector<int>;
+
+enum class Order { kSorted, kReverse, kRandom };
+
+inline const char *OrderName(Order order) {
+  switch (order) {
+    case Order::kSorted:
+      return "sorted";
+    case Order::kReverse:
+      return "reverse";
+    default:
+      return "random";
+  }
+}
+
+// A permutation of 0..n-1. The random order uses a fixed seed so that runs
+// are comparable with each other.
+inline Keys MakeKeys(std::size_t n, Order order) {
+  Keys keys(n);
+  std::iota(keys.begin(), keys.end(), 0);
+  if (order == Order::kReverse) {
+    std::reverse(keys.begin(), keys.end());
+  } else if (order == Order::kRandom) {
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+  }
+  return keys;
+}
+
+// Keeps the compiler from dropping a computation whose result is unused.
+template <typename T>
+inline void DoNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs f once and returns its wall time in seconds.
+template <typename F>
+inline double Time(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// One run of a benchmark on the given keys: the function prepares its
+// input untimed and returns the seconds spent in the measured section.
+using Run = std::function<double(const Keys &)>;
+
+// An operation measured on an s21 container and on its std counterpart.
+struct Benchmark {
+  std::string container;
+  std::string op;
+  Run s21;
+  Run std;
+};
+
+inline std::vector<Benchmark> &Registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct Registrar {
+  Registrar(std::string container, std::string op, Run s21, Run std) {
+    Registry().push_back({std::move(container), std::move(op),
+                          std::move(s21), std::move(std)});
+  }
+};
+
+}  // namespace bench
+}  // namespace s21
+
+#define S21_BENCH_CONCAT_(a, b) a##b
+#define S21_BENCH_CONCAT(a, b) S21_BENCH_CONCAT_(a, b)
+
+// Registers a benchmark at static initialisation time.
+#define S21_BENCHMARK(container, op, s21_run, std_run) \
+  static ::s21::bench::Registrar S21_BENCH_CONCAT(     \
+      s21_bench_registrar_, __LINE__)(container, op, s21_run, std_run)
+
+#endif  // S21_BENCH_H
@@ -0,0 +1,245 @@
+#ifndef S21_BTREE_SET_
+#define S21_BTREE_SET_
+
+#include <functional>
+#include <vector>
+
+#include "../tree/s21_btree.h"
+
+namespace s21 {
+// Drop-in for set over a B+-tree: several times less memory per key and
+// far fewer cache misses per lookup. Unlike set, insert and erase
+// invalidate iterators.
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
+class btree_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+  struct KeyOfValue {
+    static const Key &KeyOf(const value_type &value) { return value; }
+  };
+
+ private:
+  using Tree = BTree<Key, Key, KeyOfValue, Compare, Allocator>;
+  template <typename K>
+  using Transparent = typename Tree::template EnableIfTransparent<K>;
+
+ public:
+  using iterator = typename Tree::iterator;
+  using const_iterator = typename Tree::const_iterator;
+  btree_set() : tree_() {}
+  explicit btree_set(const Allocator &alloc) : tree_(alloc) {}
+  explicit btree_set(const Compare &comp, const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {}
+  btree_set(std::initializer_list<value_type> const &items)
+      : btree_set(items.begin(), items.end()) {}
+  // The input is sorted once and the tree built bottom up in O(n).
+  template <typename InputIt>
+  btree_set(InputIt first, InputIt last, const Compare &comp = Compare(),
+            const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.InsertRange(first, last, false);
+  }
+  btree_set(const btree_set &s) : tree_(s.tree_) {}
+  btree_set(btree_set &&s) : tree_(std::move(s.tree_)) {}
+  ~btree_set() {}
+  btree_set &operator=(btree_set &&s) {
+    tree_ = std::move(s.tree_);
+    return *this;
+  }
+  iterator begin() const noexcept { return tree_.begin(); }
+  iterator end() const noexcept { return tree_.end(); }
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare key_comp() const { return tree_.key_comp(); }
+  value_compare value_comp() const { return tree_.key_comp(); }
+  void clear() noexcept { tree_.clear(); }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_.InsertValue(value, false);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.InsertValue(std::move(value), false);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.Emplace(false, std::forward<Args>(args)...);
+  }
+  // A descent is only a few nodes deep, so the hint is not used.
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args &&...args) {
+    return tree_.Emplace(false, std::forward<Args>(args)...).first;
+  }
+  void erase(iterator pos) { tree_.erase(pos); }
+  void swap(btree_set &other) { tree_.swap(other.tree_); }
+  void merge(btree_set &other) { tree_.merge(other.tree_); }
+  iterator find(const Key &key) const { return tree_.Find(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator find(const K &key) const {
+    return tree_.Find(key);
+  }
+  bool contains(const Key &key) const { return tree_.Find(key) != end(); }
+  template <typename K, typename = Transparent<K>>
+  bool contains(const K &key) const {
+    return tree_.Find(key) != end();
+  }
+  size_type count(const Key &key) const { return tree_.Count(key); }
+  template <typename K, typename = Transparent<K>>
+  size_type count(const K &key) const {
+    return tree_.Count(key);
+  }
+  iterator lower_bound(const Key &key) const { return tree_.LowerBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return tree_.LowerBound(key);
+  }
+  iterator upper_bound(const Key &key) const { return tree_.UpperBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return tree_.UpperBound(key);
+  }
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.EqualRange(key);
+  }
+  template <typename K, typename = Transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return tree_.EqualRange(key);
+  }
+  // One sort and one merge for all the values; every position returned
+  // is valid once they are all in.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return tree_.InsertMany(false, std::forward<Args>(args)...);
+  }
+
+ private:
+  Tree tree_;
+};
+
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
+class btree_multiset {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+  struct KeyOfValue {
+    static const Key &KeyOf(const value_type &value) { return value; }
+  };
+
+ private:
+  using Tree = BTree<Key, Key, KeyOfValue, Compare, Allocator>;
+  template <typename K>
+  using Transparent = typename Tree::template EnableIfTransparent<K>;
+
+ public:
+  using iterator = typename Tree::iterator;
+  using const_iterator = typename Tree::const_iterator;
+  btree_multiset() : tree_() {}
+  explicit btree_multiset(const Allocator &alloc) : tree_(alloc) {}
+  explicit btree_multiset(const Compare &comp,
+                          const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {}
+  btree_multiset(std::initializer_list<value_type> const &items)
+      : btree_multiset(items.begin(), items.end()) {}
+  // The input is sorted once and the tree built bottom up in O(n).
+  template <typename InputIt>
+  btree_multiset(InputIt first, InputIt last, const Compare &comp = Compare(),
+                 const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.InsertRange(first, last, true);
+  }
+  btree_multiset(const btree_multiset &ms) : tree_(ms.tree_) {}
+  btree_multiset(btree_multiset &&ms) : tree_(std::move(ms.tree_)) {}
+  ~btree_multiset() {}
+  btree_multiset &operator=(btree_multiset &&ms) {
+    tree_ = std::move(ms.tree_);
+    return *this;
+  }
+  iterator begin() const noexcept { return tree_.begin(); }
+  iterator end() const noexcept { return tree_.end(); }
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare key_comp() const { return tree_.key_comp(); }
+  value_compare value_comp() const { return tree_.key_comp(); }
+  void clear() noexcept { tree_.clear(); }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_.InsertValue(value, true);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.InsertValue(std::move(value), true);
+  }
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return tree_.Emplace(true, std::forward<Args>(args)...).first;
+  }
+  // A descent is only a few nodes deep, so the hint is not used.
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args &&...args) {
+    return tree_.Emplace(true, std::forward<Args>(args)...).first;
+  }
+  void erase(iterator pos) { tree_.erase(pos); }
+  void swap(btree_multiset &other) { tree_.swap(other.tree_); }
+  void merge(btree_multiset &other) { tree_.merge(other.tree_, true); }
+  iterator find(const Key &key) const { return tree_.Find(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator find(const K &key) const {
+    return tree_.Find(key);
+  }
+  bool contains(const Key &key) const { return tree_.Find(key) != end(); }
+  template <typename K, typename = Transparent<K>>
+  bool contains(const K &key) const {
+    return tree_.Find(key) != end();
+  }
+  size_type count(const Key &key) const { return tree_.Count(key); }
+  template <typename K, typename = Transparent<K>>
+  size_type count(const K &key) const {
+    return tree_.Count(key);
+  }
+  iterator lower_bound(const Key &key) const { return tree_.LowerBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return tree_.LowerBound(key);
+  }
+  iterator upper_bound(const Key &key) const { return tree_.UpperBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return tree_.UpperBound(key);
+  }
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.EqualRange(key);
+  }
+  template <typename K, typename = Transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return tree_.EqualRange(key);
+  }
+  // One sort and one merge for all the values; every position returned
+  // is valid once they are all in.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return tree_.InsertMany(true, std::forward<Args>(args)...);
+  }
+
+ private:
+  Tree tree_;
+};
+}  // namespace s21
+
+#endif  // S21_BTREE_SET_
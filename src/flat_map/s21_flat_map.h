@@ -0,0 +1,155 @@
+#ifndef S21_FLAT_MAP_H
+#define S21_FLAT_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../tree/s21_flat_tree.h"
+
+namespace s21 {
+// Drop-in for map over one sorted array of pairs, for read-mostly maps.
+// The pairs are shifted when the array changes, so value_type is
+// std::pair<Key, T> with a mutable key, which must not be changed through
+// an iterator. Unlike map, insert and erase invalidate iterators and
+// references to the elements.
+template <class Key, class T,
+          class Allocator = std::allocator<std::pair<Key, T>>>
+class flat_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  struct Comparator {
+    static const Key &KeyOf(const value_type &value) { return value.first; }
+  };
+
+  using iterator =
+      typename FlatTree<Key, value_type, Comparator, Allocator>::iterator;
+  using const_iterator =
+      typename FlatTree<Key, value_type, Comparator, Allocator>::const_iterator;
+  flat_map() : tree_() {}
+  explicit flat_map(const Allocator &alloc) : tree_(alloc) {}
+  flat_map(std::initializer_list<value_type> const &items)
+      : flat_map(items.begin(), items.end()) {}
+  template <typename InputIt>
+  flat_map(InputIt first, InputIt last) {
+    tree_.InsertRange(first, last, false);
+  }
+  flat_map(const flat_map &m) : tree_(m.tree_) {}
+  flat_map(flat_map &&m) : tree_(std::move(m.tree_)) {}
+  ~flat_map() {}
+  flat_map &operator=(flat_map &&m) {
+    tree_ = std::move(m.tree_);
+    return *this;
+  }
+  // element access
+  T &at(const Key &key) {
+    iterator it = tree_.Find(key);
+    if (it == end()) {
+      throw std::out_of_range("key not found");
+    }
+    return it->second;
+  }
+  const T &at(const Key &key) const {
+    iterator it = tree_.Find(key);
+    if (it == end()) {
+      throw std::out_of_range("key not found");
+    }
+    return it->second;
+  }
+  T &operator[](const Key &key) { return tree_.TryEmplace(key).first->second; }
+  T &operator[](Key &&key) {
+    return tree_.TryEmplace(std::move(key)).first->second;
+  }
+  // iterators
+  iterator begin() const noexcept { return tree_.begin(); }
+  iterator end() const noexcept { return tree_.end(); }
+  // capacity
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  void reserve(size_type n) { tree_.Reserve(n); }
+  // modifiers
+  void clear() noexcept { tree_.clear(); }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_.InsertValue(value, false);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.InsertValue(std::move(value), false);
+  }
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return tree_.TryEmplace(key, obj);
+  }
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    tree_.InsertRange(first, last, false);
+  }
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    return tree_.InsertOrAssign(value_type(key, obj));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return tree_.TryEmplace(key, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return tree_.TryEmplace(std::move(key), std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.Emplace(false, std::forward<Args>(args)...);
+  }
+  // A binary search is cheap, so the hint is not used.
+  template <typename... Args>
+  iterator emplace_hint(const_iterator, Args &&...args) {
+    return tree_.Emplace(false, std::forward<Args>(args)...).first;
+  }
+  iterator erase(const_iterator pos) { return tree_.erase(pos); }
+  void swap(flat_map &other) { tree_.swap(other.tree_); }
+  void merge(flat_map &other) { tree_.merge(other.tree_); }
+  // lookup
+  template <typename K>
+  iterator find(const K &key) const {
+    return tree_.Find(key);
+  }
+  template <typename K>
+  bool contains(const K &key) const {
+    return tree_.Find(key) != end();
+  }
+  template <typename K>
+  size_type count(const K &key) const {
+    return tree_.Count(key);
+  }
+  template <typename K>
+  iterator lower_bound(const K &key) const {
+    return tree_.LowerBound(key);
+  }
+  template <typename K>
+  iterator upper_bound(const K &key) const {
+    return tree_.UpperBound(key);
+  }
+  template <typename K>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return tree_.EqualRange(key);
+  }
+
+  // One sort and one merge for all the pairs, not one shift each.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return tree_.InsertMany(false, std::forward<Args>(args)...);
+  }
+
+ private:
+  FlatTree<Key, value_type, Comparator, Allocator> tree_;
+};
+}  // namespace s21
+
+#endif  // S21_FLAT_MAP_H
@@ -0,0 +1,181 @@
+#ifndef S21_FLAT_SET_H
+#define S21_FLAT_SET_H
+
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "../tree/s21_flat_tree.h"
+
+namespace s21 {
+// Drop-in for set over one sorted array, for read-mostly sets: lookups and
+// iteration are the fastest of all the sets, a single insert or erase is
+// O(n). Add values in bulk with the range constructor or insert_many,
+// which sort and merge once. Unlike set, insert and erase invalidate
+// iterators.
+template <class Key, class Allocator = std::allocator<Key>>
+class flat_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  struct Comparator {
+    static const Key &KeyOf(const value_type &value) { return value; }
+  };
+
+  using iterator =
+      typename FlatTree<Key, Key, Comparator, Allocator>::const_iterator;
+  using const_iterator = iterator;
+  flat_set() : tree_() {}
+  explicit flat_set(const Allocator &alloc) : tree_(alloc) {}
+  flat_set(std::initializer_list<value_type> const &items)
+      : flat_set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  flat_set(InputIt first, InputIt last) {
+    tree_.InsertRange(first, last, false);
+  }
+  flat_set(const flat_set &s) : tree_(s.tree_) {}
+  flat_set(flat_set &&s) : tree_(std::move(s.tree_)) {}
+  ~flat_set() {}
+  flat_set &operator=(flat_set &&s) {
+    tree_ = std::move(s.tree_);
+    return *this;
+  }
+  iterator begin() const noexcept { return tree_.begin(); }
+  iterator end() const noexcept { return tree_.end(); }
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  void reserve(size_type n) { tree_.Reserve(n); }
+  void clear() noexcept { tree_.clear(); }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_.InsertValue(value, false);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.InsertValue(std::move(value), false);
+  }
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    tree_.InsertRange(first, last, false);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.Emplace(false, std::forward<Args>(args)...);
+  }
+  // A binary search is cheap, so the hint is not used.
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args &&...args) {
+    return tree_.Emplace(false, std::forward<Args>(args)...).first;
+  }
+  iterator erase(iterator pos) { return tree_.erase(pos); }
+  void swap(flat_set &other) { tree_.swap(other.tree_); }
+  void merge(flat_set &other) { tree_.merge(other.tree_); }
+  iterator find(const Key &key) const { return tree_.Find(key); }
+  bool contains(const Key &key) const { return tree_.Find(key) != end(); }
+  size_type count(const Key &key) const { return tree_.Count(key); }
+  iterator lower_bound(const Key &key) const { return tree_.LowerBound(key); }
+  iterator upper_bound(const Key &key) const { return tree_.UpperBound(key); }
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.EqualRange(key);
+  }
+  // One sort and one merge for all the values, not one shift each.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    auto placed = tree_.InsertMany(false, std::forward<Args>(args)...);
+    return std::vector<std::pair<iterator, bool>>(placed.begin(),
+                                                  placed.end());
+  }
+
+ private:
+  FlatTree<Key, Key, Comparator, Allocator> tree_;
+};
+
+template <class Key, class Allocator = std::allocator<Key>>
+class flat_multiset {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  struct Comparator {
+    static const Key &KeyOf(const value_type &value) { return value; }
+  };
+
+  using iterator =
+      typename FlatTree<Key, Key, Comparator, Allocator>::const_iterator;
+  using const_iterator = iterator;
+  flat_multiset() : tree_() {}
+  explicit flat_multiset(const Allocator &alloc) : tree_(alloc) {}
+  flat_multiset(std::initializer_list<value_type> const &items)
+      : flat_multiset(items.begin(), items.end()) {}
+  template <typename InputIt>
+  flat_multiset(InputIt first, InputIt last) {
+    tree_.InsertRange(first, last, true);
+  }
+  flat_multiset(const flat_multiset &ms) : tree_(ms.tree_) {}
+  flat_multiset(flat_multiset &&ms) : tree_(std::move(ms.tree_)) {}
+  ~flat_multiset() {}
+  flat_multiset &operator=(flat_multiset &&ms) {
+    tree_ = std::move(ms.tree_);
+    return *this;
+  }
+  iterator begin() const noexcept { return tree_.begin(); }
+  iterator end() const noexcept { return tree_.end(); }
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  void reserve(size_type n) { tree_.Reserve(n); }
+  void clear() noexcept { tree_.clear(); }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_.InsertValue(value, true);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.InsertValue(std::move(value), true);
+  }
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    tree_.InsertRange(first, last, true);
+  }
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return tree_.Emplace(true, std::forward<Args>(args)...).first;
+  }
+  // A binary search is cheap, so the hint is not used.
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args &&...args) {
+    return tree_.Emplace(true, std::forward<Args>(args)...).first;
+  }
+  iterator erase(iterator pos) { return tree_.erase(pos); }
+  void swap(flat_multiset &other) { tree_.swap(other.tree_); }
+  void merge(flat_multiset &other) { tree_.merge(other.tree_, true); }
+  size_type count(const Key &key) const { return tree_.Count(key); }
+  iterator find(const Key &key) const { return tree_.Find(key); }
+  bool contains(const Key &key) const { return tree_.Find(key) != end(); }
+  iterator lower_bound(const Key &key) const { return tree_.LowerBound(key); }
+  iterator upper_bound(const Key &key) const { return tree_.UpperBound(key); }
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.EqualRange(key);
+  }
+  // One sort and one merge for all the values, not one shift each.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    auto placed = tree_.InsertMany(true, std::forward<Args>(args)...);
+    return std::vector<std::pair<iterator, bool>>(placed.begin(),
+                                                  placed.end());
+  }
+
+ private:
+  FlatTree<Key, Key, Comparator, Allocator> tree_;
+};
+}  // namespace s21
+
+#endif  // S21_FLAT_SET_H
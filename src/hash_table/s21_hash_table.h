@@ -0,0 +1,571 @@
+#ifndef S21_HASH_TABLE_
+#define S21_HASH_TABLE_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../s21_type_traits.h"
+
+namespace s21 {
+
+// Open-addressing hash table behind unordered_set and unordered_map, laid
+// out like a Swiss table. Each slot has a control byte that says empty,
+// deleted, or holds seven bits of the slot's hash. A lookup compares the
+// bytes of a whole group of slots at once and only reads the slots whose
+// seven bits match, so a miss rarely touches a value at all. The bytes and
+// the slots share one flat allocation.
+//
+// Values live in the slots themselves: a rehash moves them, so any insert
+// that grows the table invalidates iterators. erase() leaves the others
+// valid.
+template <typename Key, typename T, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator = std::allocator<T>>
+class HashTable {
+ public:
+  using key_type = Key;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  // Lets a wrapper take lookups by any K when both the hasher and the key
+  // equality are transparent, as std::unordered_map does since C++20.
+  template <typename K>
+  using EnableIfTransparent =
+      std::enable_if_t<IsTransparent<Hash>::value &&
+                           IsTransparent<KeyEqual>::value,
+                       K>;
+
+  using ctrl_t = std::int8_t;
+  static constexpr ctrl_t kEmpty = -128;
+  static constexpr ctrl_t kDeleted = -2;
+  static constexpr ctrl_t kSentinel = -1;  // after the last slot
+  static constexpr size_type kGroupWidth = 16;
+  static constexpr size_type kPrefetchBytes = size_type{1} << 20;
+
+  // Control bytes of one group and the positions among them that match,
+  // as a mask with bit i for byte i.
+  class Group {
+   public:
+#if defined(__SSE2__)
+    explicit Group(const ctrl_t *ctrl)
+        : bytes_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+    std::uint32_t Match(ctrl_t h2) const {
+      return Mask(_mm_cmpeq_epi8(bytes_, _mm_set1_epi8(h2)));
+    }
+    std::uint32_t MatchEmpty() const {
+      return Mask(_mm_cmpeq_epi8(bytes_, _mm_set1_epi8(kEmpty)));
+    }
+    std::uint32_t MatchEmptyOrDeleted() const {
+      return Mask(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), bytes_));
+    }
+
+   private:
+    static std::uint32_t Mask(__m128i lanes) {
+      return static_cast<std::uint32_t>(_mm_movemask_epi8(lanes));
+    }
+
+    __m128i bytes_;
+#else
+    explicit Group(const ctrl_t *ctrl) : ctrl_(ctrl) {}
+    std::uint32_t Match(ctrl_t h2) const {
+      std::uint32_t mask = 0;
+      for (size_type i = 0; i != kGroupWidth; ++i) {
+        mask |= static_cast<std::uint32_t>(ctrl_[i] == h2) << i;
+      }
+      return mask;
+    }
+    std::uint32_t MatchEmpty() const { return Match(kEmpty); }
+    std::uint32_t MatchEmptyOrDeleted() const {
+      std::uint32_t mask = 0;
+      for (size_type i = 0; i != kGroupWidth; ++i) {
+        mask |= static_cast<std::uint32_t>(ctrl_[i] < kSentinel) << i;
+      }
+      return mask;
+    }
+
+   private:
+    const ctrl_t *ctrl_;
+#endif
+  };
+
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    iterator() = default;
+    reference operator*() const { return *slot_; }
+    pointer operator->() const { return slot_; }
+    iterator &operator++() {
+      ++ctrl_;
+      ++slot_;
+      SkipFree();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator it(*this);
+      ++(*this);
+      return it;
+    }
+    bool operator==(const iterator &other) const {
+      return ctrl_ == other.ctrl_;
+    }
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+   private:
+    friend class HashTable;
+    iterator(const ctrl_t *ctrl, T *slot) : ctrl_(ctrl), slot_(slot) {}
+
+    // Steps over free slots a group at a time; the sentinel stops it.
+    void SkipFree() {
+      while (*ctrl_ < kSentinel) {
+        size_type shift = CountTrailingZeros(
+            ~Group(ctrl_).MatchEmptyOrDeleted());
+        ctrl_ += shift;
+        slot_ += shift;
+      }
+    }
+
+    const ctrl_t *ctrl_{nullptr};
+    T *slot_{nullptr};
+  };
+  using const_iterator = iterator;
+
+  HashTable() = default;
+  HashTable(size_type bucket_count, const Hash &hash, const KeyEqual &equal,
+            const Allocator &alloc)
+      : hash_(hash), equal_(equal), alloc_(alloc) {
+    reserve(bucket_count);
+  }
+  HashTable(const HashTable &other)
+      : hash_(other.hash_),
+        equal_(other.equal_),
+        alloc_(std::allocator_traits<Allocator>::
+                   select_on_container_copy_construction(other.alloc_)) {
+    try {
+      reserve(other.size_);
+      for (const value_type &value : other) InsertFresh(value);
+    } catch (...) {
+      Release();
+      throw;
+    }
+  }
+  HashTable(HashTable &&other) noexcept
+      : hash_(other.hash_), equal_(other.equal_), alloc_(other.alloc_) {
+    swap(other);
+  }
+  ~HashTable() { Release(); }
+  HashTable &operator=(HashTable &&other) {
+    Release();
+    swap(other);
+    return *this;
+  }
+
+  iterator begin() const noexcept {
+    if (capacity_ == 0) return end();
+    iterator it(ctrl_, slots_);
+    it.SkipFree();
+    return it;
+  }
+  iterator end() const noexcept {
+    return iterator(ctrl_ + capacity_, slots_ + capacity_);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / 2 /
+           (sizeof(value_type) + 1);
+  }
+  allocator_type get_allocator() const { return alloc_; }
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+
+  size_type bucket_count() const noexcept { return capacity_; }
+  float load_factor() const noexcept {
+    return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_;
+  }
+  float max_load_factor() const noexcept { return 0.875f; }
+
+  // Keeps the allocation, so refilling the table does not rehash.
+  void clear() noexcept {
+    if (capacity_ == 0) return;
+    DestroyValues();
+    ResetCtrl();
+    size_ = 0;
+  }
+
+  void swap(HashTable &other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+    std::swap(alloc_, other.alloc_);
+  }
+
+  // Makes room for count values without another rehash.
+  void reserve(size_type count) {
+    if (count > size_ + growth_left_) Resize(CapacityFor(count));
+  }
+
+  // Rehashes into the smallest table that fits max(count, size()) values
+  // and drops the deleted markers.
+  void rehash(size_type count) {
+    if (count == 0 && size_ == 0) {
+      Release();
+      return;
+    }
+    size_type capacity = CapacityFor(std::max(count, size_));
+    if (capacity != capacity_ ||
+        size_ + growth_left_ < capacity_ - capacity_ / 8) {
+      Resize(capacity);
+    }
+  }
+
+  std::pair<iterator, bool> InsertValue(const value_type &value) {
+    return InsertKeyed(KeyOfValue::KeyOf(value), value);
+  }
+  std::pair<iterator, bool> InsertValue(value_type &&value) {
+    return InsertKeyed(KeyOfValue::KeyOf(value), std::move(value));
+  }
+
+  // The key is only known once the value exists, so it is built on the
+  // stack and moved into its slot.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return InsertValue(std::move(value));
+  }
+
+  // Builds the value in its slot, and only when key is absent
+  // (map::try_emplace).
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(K &&key, Args &&...args) {
+    return InsertKeyed(key, std::piecewise_construct,
+                       std::forward_as_tuple(std::forward<K>(key)),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // Assigns obj to the mapped value of an equal key, otherwise builds the
+  // value in its slot like TryEmplace (map::insert_or_assign). TryEmplace
+  // only forwards obj when it inserts, so it is still intact for a hit.
+  template <typename K, typename M>
+  std::pair<iterator, bool> InsertOrAssign(K &&key, M &&obj) {
+    auto result = TryEmplace(std::forward<K>(key), std::forward<M>(obj));
+    if (!result.second) result.first->second = std::forward<M>(obj);
+    return result;
+  }
+
+  // Reserves room for every argument first, so no insert rehashes and the
+  // position reported for an earlier argument stays valid.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> InsertMany(Args &&...args) {
+    reserve(size_ + sizeof...(args));
+    std::vector<std::pair<iterator, bool>> result;
+    result.reserve(sizeof...(args));
+    (result.push_back(Emplace(std::forward<Args>(args))), ...);
+    return result;
+  }
+
+  template <typename InputIt>
+  void InsertRange(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) Emplace(*first);
+  }
+
+  // Moves every value of other whose key is not here into this table; the
+  // rest stay in other.
+  void merge(HashTable &other) {
+    if (this == &other) return;
+    for (size_type i = 0; i != other.capacity_; ++i) {
+      if (other.ctrl_[i] < 0) continue;
+      value_type &value = other.slots_[i];
+      const auto &key = KeyOfValue::KeyOf(value);
+      size_type hash = Mix(hash_(key));
+      if (size_ != 0 && FindHashed(key, hash) != end()) continue;
+      InsertAt(PrepareInsert(hash), hash, std::move(value));
+      other.EraseAt(i);
+    }
+  }
+
+  void erase(iterator pos) {
+    if (pos.ctrl_ == nullptr || pos.ctrl_ == ctrl_ + capacity_ ||
+        *pos.ctrl_ < 0) {
+      throw std::invalid_argument("wrong argument");
+    }
+    EraseAt(static_cast<size_type>(pos.ctrl_ - ctrl_));
+  }
+
+  template <typename K>
+  iterator Find(const K &key) const {
+    if (size_ == 0) return end();
+    return FindHashed(key, Mix(hash_(key)));
+  }
+
+  template <typename K>
+  size_type Count(const K &key) const {
+    return Find(key) != end() ? 1 : 0;
+  }
+
+ private:
+  // One allocation holds the control bytes, then the slots. Its unit is
+  // aligned for both the groups and the values.
+  struct alignas(std::max(alignof(value_type), alignof(std::max_align_t)))
+      Block {
+    unsigned char bytes[std::max(alignof(value_type),
+                                 alignof(std::max_align_t))];
+  };
+  using block_traits = typename std::allocator_traits<
+      Allocator>::template rebind_traits<Block>;
+  using value_traits = std::allocator_traits<Allocator>;
+
+  static size_type CountTrailingZeros(std::uint32_t mask) {
+#if defined(__GNUC__)
+    return static_cast<size_type>(__builtin_ctz(mask));
+#else
+    size_type count = 0;
+    for (; (mask & 1) == 0; mask >>= 1) ++count;
+    return count;
+#endif
+  }
+
+  // std::hash of an integer is the integer itself, so the bits are mixed
+  // before the low seven go to the control byte and the rest pick the
+  // group.
+  static size_type Mix(size_type hash) {
+    std::uint64_t mixed =
+        static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_type>(mixed ^ (mixed >> 32));
+  }
+  static size_type H1(size_type hash) { return hash >> 7; }
+  static ctrl_t H2(size_type hash) { return static_cast<ctrl_t>(hash & 0x7F); }
+
+  // Probing visits whole groups in triangular steps, which covers every
+  // group of a power-of-two table. A group with an empty byte ends it: a
+  // value is never placed past a group that had room.
+  size_type GroupMask() const { return capacity_ / kGroupWidth - 1; }
+
+  template <typename K>
+  iterator FindHashed(const K &key, size_type hash) const {
+    size_type group = H1(hash) & GroupMask();
+    for (size_type step = 0;; group = (group + ++step) & GroupMask()) {
+      size_type base = group * kGroupWidth;
+      PrefetchSlots(base);
+      Group bytes(ctrl_ + base);
+      for (std::uint32_t mask = bytes.Match(H2(hash)); mask != 0;
+           mask &= mask - 1) {
+        size_type index = base + CountTrailingZeros(mask);
+        if (equal_(KeyOfValue::KeyOf(slots_[index]), key)) {
+          return iterator(ctrl_ + index, slots_ + index);
+        }
+      }
+      if (bytes.MatchEmpty() != 0) return end();
+    }
+  }
+
+  // The slots of a group are fetched while its control bytes load, so a
+  // hit on a table too large for the cache waits for one miss rather than
+  // two in a row. Smaller tables only pay for the extra instructions.
+  void PrefetchSlots(size_type base) const {
+#if defined(__GNUC__)
+    if (capacity_ * sizeof(value_type) < kPrefetchBytes) return;
+    const char *slots = reinterpret_cast<const char *>(slots_ + base);
+    for (size_type offset = 0; offset < kGroupWidth * sizeof(value_type);
+         offset += 64) {
+      __builtin_prefetch(slots + offset);
+    }
+#else
+    (void)base;
+#endif
+  }
+
+  // First empty or deleted slot on the probe path of hash.
+  size_type FindFree(size_type hash) const {
+    size_type group = H1(hash) & GroupMask();
+    for (size_type step = 0;; group = (group + ++step) & GroupMask()) {
+      std::uint32_t mask =
+          Group(ctrl_ + group * kGroupWidth).MatchEmptyOrDeleted();
+      if (mask != 0) return group * kGroupWidth + CountTrailingZeros(mask);
+    }
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> InsertKeyed(const K &key, Args &&...args) {
+    size_type hash = Mix(hash_(key));
+    if (size_ != 0) {
+      iterator found = FindHashed(key, hash);
+      if (found != end()) return {found, false};
+    }
+    size_type index = PrepareInsert(hash);
+    return {InsertAt(index, hash, std::forward<Args>(args)...), true};
+  }
+
+  // The slot an insert of hash should fill. A deleted slot can always be
+  // reused; taking an empty one needs growth left, or the table is
+  // rehashed first.
+  size_type PrepareInsert(size_type hash) {
+    if (capacity_ != 0) {
+      size_type index = FindFree(hash);
+      if (growth_left_ != 0 || ctrl_[index] == kDeleted) return index;
+    }
+    Grow();
+    return FindFree(hash);
+  }
+
+  // Builds the value in the free slot at index, then marks it full, so a
+  // throwing constructor leaves the table as it was.
+  template <typename... Args>
+  iterator InsertAt(size_type index, size_type hash, Args &&...args) {
+    Allocator alloc(alloc_);
+    value_traits::construct(alloc, slots_ + index,
+                            std::forward<Args>(args)...);
+    if (ctrl_[index] == kEmpty) --growth_left_;
+    ctrl_[index] = H2(hash);
+    ++size_;
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+
+  // Inserts a value known to be absent, into a table known to have room.
+  template <typename V>
+  void InsertFresh(V &&value) {
+    size_type hash = Mix(hash_(KeyOfValue::KeyOf(value)));
+    InsertAt(FindFree(hash), hash, std::forward<V>(value));
+  }
+
+  // A slot whose group still has an empty byte can go back to empty: no
+  // probe ever passed that group. Otherwise it must stay deleted so that
+  // probes carry on past it.
+  void EraseAt(size_type index) {
+    Allocator alloc(alloc_);
+    value_traits::destroy(alloc, slots_ + index);
+    --size_;
+    if (Group(ctrl_ + index / kGroupWidth * kGroupWidth).MatchEmpty() != 0) {
+      ctrl_[index] = kEmpty;
+      ++growth_left_;
+    } else {
+      ctrl_[index] = kDeleted;
+    }
+  }
+
+  // Out of room: rehash at the same size when deleted slots are the cause,
+  // otherwise double. Both keep the load at or below 7/8.
+  void Grow() {
+    if (capacity_ == 0) {
+      Resize(kGroupWidth);
+    } else if (size_ * 32 <= capacity_ * 25) {
+      Resize(capacity_);
+    } else {
+      Resize(capacity_ * 2);
+    }
+  }
+
+  static size_type CapacityFor(size_type count) {
+    size_type capacity = kGroupWidth;
+    while (capacity - capacity / 8 < count) capacity *= 2;
+    return capacity;
+  }
+
+  // Moves the values into a fresh table of the given capacity. Values are
+  // copied when their move may throw, so a throwing copy or allocation
+  // leaves this table intact; a throwing hasher, as with std, may not.
+  void Resize(size_type capacity) {
+    HashTable fresh(hash_, equal_, alloc_);
+    fresh.Allocate(capacity);
+    for (size_type i = 0; i != capacity_; ++i) {
+      if (ctrl_[i] >= 0) fresh.InsertFresh(std::move_if_noexcept(slots_[i]));
+    }
+    swap(fresh);
+  }
+
+  HashTable(const Hash &hash, const KeyEqual &equal, const Allocator &alloc)
+      : hash_(hash), equal_(equal), alloc_(alloc) {}
+
+  static size_type SlotsOffset(size_type capacity) {
+    size_type align = alignof(value_type);
+    return (capacity + kGroupWidth + align - 1) / align * align;
+  }
+  static size_type BlocksFor(size_type capacity) {
+    size_type bytes = SlotsOffset(capacity) + capacity * sizeof(value_type);
+    return (bytes + sizeof(Block) - 1) / sizeof(Block);
+  }
+
+  // A table that is still empty; capacity is a power of two and at least
+  // one group. One group of bytes past the sentinel lets an iterator load
+  // a full group wherever it stands.
+  void Allocate(size_type capacity) {
+    if (capacity > max_size()) throw std::length_error("table too large");
+    typename block_traits::allocator_type alloc(alloc_);
+    Block *blocks = block_traits::allocate(alloc, BlocksFor(capacity));
+    unsigned char *bytes = reinterpret_cast<unsigned char *>(blocks);
+    ctrl_ = reinterpret_cast<ctrl_t *>(bytes);
+    slots_ = reinterpret_cast<value_type *>(bytes + SlotsOffset(capacity));
+    capacity_ = capacity;
+    ResetCtrl();
+  }
+
+  void ResetCtrl() noexcept {
+    std::memset(ctrl_, static_cast<unsigned char>(kEmpty),
+                capacity_ + kGroupWidth);
+    ctrl_[capacity_] = kSentinel;
+    growth_left_ = capacity_ - capacity_ / 8;
+  }
+
+  void DestroyValues() noexcept {
+    Allocator alloc(alloc_);
+    for (size_type i = 0; i != capacity_; ++i) {
+      if (ctrl_[i] >= 0) value_traits::destroy(alloc, slots_ + i);
+    }
+  }
+
+  void Release() noexcept {
+    if (capacity_ == 0) return;
+    DestroyValues();
+    typename block_traits::allocator_type alloc(alloc_);
+    block_traits::deallocate(alloc, reinterpret_cast<Block *>(ctrl_),
+                             BlocksFor(capacity_));
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = size_ = growth_left_ = 0;
+  }
+
+  ctrl_t *ctrl_{nullptr};
+  value_type *slots_{nullptr};
+  size_type capacity_{0};
+  size_type size_{0};
+  size_type growth_left_{0};
+  Hash hash_;
+  KeyEqual equal_;
+  Allocator alloc_;
+};
+
+}  // namespace s21
+
+#endif  // S21_HASH_TABLE_
@@ -0,0 +1,265 @@
+#ifndef S21_INTRUSIVE_LIST_H
+#define S21_INTRUSIVE_LIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+template <typename T, typename Tag>
+class intrusive_list;
+
+// The links an intrusive_list threads through an object. A type derives
+// from one hook per list it can be in at the same time, telling them apart
+// by Tag:
+//
+//   struct Lru;
+//   struct Page : s21::list_hook<>, s21::list_hook<Lru> { ... };
+//
+// A copied object starts out in no list; the links are never copied.
+template <typename Tag = void>
+class list_hook {
+ public:
+  list_hook() = default;
+  list_hook(const list_hook &) noexcept {}
+  list_hook &operator=(const list_hook &) noexcept { return *this; }
+
+  bool is_linked() const noexcept { return next_ != nullptr; }
+
+ private:
+  template <typename, typename>
+  friend class intrusive_list;
+
+  list_hook *prev_{nullptr};
+  list_hook *next_{nullptr};
+};
+
+// A list of objects that live elsewhere, for example in a pool. Insert and
+// erase only relink the hook inside the object, so they never allocate or
+// copy, and an object knows its own position: iterator_to is O(1). The
+// list does not own its objects; each must outlive its membership, and
+// clearing or destroying the list leaves them unlinked.
+template <typename T, typename Tag = void>
+class intrusive_list {
+  using Hook = list_hook<Tag>;
+  static_assert(std::is_base_of_v<Hook, T>, "T must derive from list_hook");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  // iterator converts to const_iterator, which only hands out const
+  // references.
+  template <bool kConst>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<kConst, const T *, T *>;
+    using reference = std::conditional_t<kConst, const T &, T &>;
+
+    Iterator() = default;
+    template <bool kOther, typename = std::enable_if_t<kConst && !kOther>>
+    Iterator(const Iterator<kOther> &other) : hook_(other.hook_) {}
+    reference operator*() const { return *static_cast<T *>(hook_); }
+    pointer operator->() const { return static_cast<T *>(hook_); }
+    Iterator &operator++() {
+      hook_ = hook_->next_;
+      return *this;
+    }
+    Iterator &operator--() {
+      hook_ = hook_->prev_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator it(*this);
+      ++(*this);
+      return it;
+    }
+    Iterator operator--(int) {
+      Iterator it(*this);
+      --(*this);
+      return it;
+    }
+    template <bool kOther>
+    bool operator==(const Iterator<kOther> &other) const {
+      return hook_ == other.hook_;
+    }
+    template <bool kOther>
+    bool operator!=(const Iterator<kOther> &other) const {
+      return hook_ != other.hook_;
+    }
+
+   private:
+    friend class intrusive_list;
+    template <bool>
+    friend class Iterator;
+    explicit Iterator(Hook *hook) : hook_(hook) {}
+
+    Hook *hook_{nullptr};
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  intrusive_list() { Reset(); }
+  intrusive_list(const intrusive_list &) = delete;
+  intrusive_list(intrusive_list &&other) noexcept {
+    Reset();
+    swap(other);
+  }
+  ~intrusive_list() { clear(); }
+  intrusive_list &operator=(const intrusive_list &) = delete;
+  intrusive_list &operator=(intrusive_list &&other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // element access
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *--end(); }
+  const_reference back() const { return *--end(); }
+
+  // iterators
+  iterator begin() noexcept { return iterator(head_.next_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(head_.next_);
+  }
+  iterator end() noexcept { return iterator(&head_); }
+  const_iterator end() const noexcept { return const_iterator(Head()); }
+  // The position of an object linked into this list.
+  iterator iterator_to(reference value) noexcept {
+    return iterator(static_cast<Hook *>(&value));
+  }
+  const_iterator iterator_to(const_reference value) const noexcept {
+    return const_iterator(static_cast<Hook *>(&const_cast<T &>(value)));
+  }
+
+  // capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  // modifiers
+  // Unlinks every object, in O(n).
+  void clear() noexcept {
+    for (Hook *hook = head_.next_; hook != &head_;) {
+      Hook *next = hook->next_;
+      hook->prev_ = hook->next_ = nullptr;
+      hook = next;
+    }
+    Reset();
+    size_ = 0;
+  }
+
+  // Links value before pos. It must not be in a list of this Tag yet.
+  iterator insert(const_iterator pos, reference value) {
+    Hook *hook = static_cast<Hook *>(&value);
+    if (hook->is_linked()) {
+      throw std::invalid_argument("value is already in a list");
+    }
+    LinkBefore(pos.hook_, hook);
+    ++size_;
+    return iterator(hook);
+  }
+  void push_back(reference value) { insert(end(), value); }
+  void push_front(reference value) { insert(begin(), value); }
+
+  // Unlinks the object at pos and returns the position after it.
+  iterator erase(const_iterator pos) {
+    if (pos.hook_ == nullptr || pos.hook_ == &head_) {
+      throw std::invalid_argument("Invalid argument");
+    }
+    Hook *next = pos.hook_->next_;
+    Unlink(pos.hook_);
+    --size_;
+    return iterator(next);
+  }
+  void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("list is empty");
+    }
+    erase(--end());
+  }
+  void pop_front() {
+    if (empty()) {
+      throw std::out_of_range("list is empty");
+    }
+    erase(begin());
+  }
+
+  void swap(intrusive_list &other) noexcept {
+    std::swap(head_.prev_, other.head_.prev_);
+    std::swap(head_.next_, other.head_.next_);
+    std::swap(size_, other.size_);
+    Adopt(other.head_);
+    other.Adopt(head_);
+  }
+
+  // Moves every object of other before pos.
+  void splice(const_iterator pos, intrusive_list &other) noexcept {
+    if (this == &other || other.empty()) return;
+    Hook *first = other.head_.next_;
+    Hook *last = other.head_.prev_;
+    first->prev_ = pos.hook_->prev_;
+    last->next_ = pos.hook_;
+    pos.hook_->prev_->next_ = first;
+    pos.hook_->prev_ = last;
+    size_ += other.size_;
+    other.size_ = 0;
+    other.Reset();
+  }
+  // Moves the object at it, which may be in this list, before pos; an LRU
+  // touch is splice(begin(), *this, it).
+  void splice(const_iterator pos, intrusive_list &other,
+              const_iterator it) noexcept {
+    if (it == pos || it.hook_->next_ == pos.hook_) return;
+    Unlink(it.hook_);
+    LinkBefore(pos.hook_, it.hook_);
+    --other.size_;
+    ++size_;
+  }
+
+ private:
+  Hook *Head() const { return const_cast<Hook *>(&head_); }
+
+  void Reset() noexcept { head_.prev_ = head_.next_ = &head_; }
+
+  static void LinkBefore(Hook *pos, Hook *hook) noexcept {
+    hook->prev_ = pos->prev_;
+    hook->next_ = pos;
+    pos->prev_->next_ = hook;
+    pos->prev_ = hook;
+  }
+
+  static void Unlink(Hook *hook) noexcept {
+    hook->prev_->next_ = hook->next_;
+    hook->next_->prev_ = hook->prev_;
+    hook->prev_ = hook->next_ = nullptr;
+  }
+
+  // Points the end objects of a head just swapped in back at it.
+  void Adopt(Hook &old_head) noexcept {
+    if (head_.next_ == &old_head) {
+      Reset();
+    } else {
+      head_.next_->prev_ = &head_;
+      head_.prev_->next_ = &head_;
+    }
+  }
+
+  Hook head_;
+  size_type size_{0};
+};
+
+}  // namespace s21
+
+#endif  // S21_INTRUSIVE_LIST_H
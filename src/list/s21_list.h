@@ -1,13 +1,19 @@
 #ifndef S21_LIST_H
 #define S21_LIST_H
 
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../allocator/s21_node_pool.h"
 
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class list {
  public:
   //  List Member type
@@ -15,6 +21,7 @@ class list {
   using reference = T&;
   using const_reference = const T&;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
 
  private:
   struct Node {
@@ -22,18 +29,24 @@ class list {
     Node* prev_;
     Node* next_;
 
-    Node(const value_type& value)
-        : value_(value), prev_(nullptr), next_(nullptr) {}
+    template <typename... Args>
+    explicit Node(Args&&... args)
+        : value_(std::forward<Args>(args)...), prev_(nullptr), next_(nullptr) {}
   };
 
+  using node_allocator = typename NodePool<Node, Allocator>::allocator_type;
+  using node_traits = std::allocator_traits<node_allocator>;
+
   Node* head_;
   Node* tail_;
   Node* end_;
   size_type size_;
+  NodePool<Node, Allocator> pool_;
 
  public:
   //  List Functions
   list();
+  explicit list(const Allocator& alloc);
   list(size_type n);
   list(std::initializer_list<value_type> const& items);
   list(const list& l);
@@ -49,18 +62,29 @@ class list {
   bool empty();
   size_type size();
   size_type max_size();
+  allocator_type get_allocator() const;
 
   // List Modifiers
   void clear();
   void push_back(const_reference value);
+  void push_back(value_type&& value);
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
   void pop_back();
   void push_front(const_reference value);
+  void push_front(value_type&& value);
+  template <typename... Args>
+  reference emplace_front(Args&&... args);
   void pop_front();
   void swap(list& other);
   void merge(list& other);
+  template <typename Compare>
+  void merge(list& other, Compare comp);
   void reverse();
   void unique();
   void sort();
+  template <typename Compare>
+  void sort(Compare comp);
 
   template <typename value_type>
   class ListIterator {
@@ -119,7 +143,7 @@ class list {
 
    private:
     Node* ptr_ = nullptr;
-    friend class list<T>;
+    friend class list<T, Allocator>;
   };
 
   template <typename value_type>
@@ -141,14 +165,31 @@ class list {
 
   // List Modifiers
   iterator insert(iterator pos, const_reference value);
+  iterator insert(iterator pos, value_type&& value);
+  template <typename... Args>
+  iterator emplace(iterator pos, Args&&... args);
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args&&... args);
+  template <typename... Args>
+  void insert_many_back(Args&&... args);
+  template <typename... Args>
+  void insert_many_front(Args&&... args);
   void erase(iterator pos);
   void splice(const_iterator pos, list& other);
+  void splice(const_iterator pos, list& other, const_iterator it);
+  void splice(const_iterator pos, list& other, const_iterator first,
+              const_iterator last);
 
  private:
   // Support
   void change_end();
-  void quick_sort(iterator left, iterator right);
-  iterator partition(iterator first, iterator last);
+  Node* create_end();
+  void destroy_end();
+  template <typename Compare>
+  static Node* merge_chains(Node* a, Node* b, Compare& comp);
+  void relink(Node* first);
+  void link_before(Node* pos, Node* first, Node* last);
+  void unlink(Node* first, Node* last);
   void copy(const list& l);
   void print_list();
 };
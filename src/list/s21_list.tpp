@@ -5,124 +5,177 @@
 
 namespace s21 {
 //  List Functions
-template <typename value_type>
-list<value_type>::list()
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list()
     : head_(nullptr), tail_(nullptr), end_(nullptr), size_(0) {
-  end_ = new Node(size_);
+  end_ = create_end();
   change_end();
 }
 
-template <typename value_type>
-list<value_type>::list(size_type n)
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(const Allocator& alloc)
+    : head_(nullptr), tail_(nullptr), end_(nullptr), size_(0), pool_(alloc) {
+  end_ = create_end();
+  change_end();
+}
+
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(size_type n)
     : head_(nullptr), tail_(nullptr), end_(nullptr), size_(0) {
   if (n >= max_size()) {
     throw std::out_of_range("Limit of the container is exceeded");
   }
-  end_ = new Node(size_);
+  end_ = create_end();
   for (size_type i = 0; i < n; ++i) {
     push_back(value_type());
   }
   change_end();
 }
 
-template <typename value_type>
-list<value_type>::list(std::initializer_list<value_type> const& items)
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(
+    std::initializer_list<value_type> const& items)
     : head_(nullptr), tail_(nullptr), end_(nullptr), size_(0) {
-  end_ = new Node(size_);
+  end_ = create_end();
   for (const auto& item : items) {
     push_back(item);
     change_end();
   }
 }
 
-template <typename value_type>
-list<value_type>::list(const list& l)
-    : head_(nullptr), tail_(nullptr), end_(nullptr), size_(0) {
-  end_ = new Node(size_);
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(const list& l)
+    : head_(nullptr),
+      tail_(nullptr),
+      end_(nullptr),
+      size_(0),
+      pool_(node_traits::select_on_container_copy_construction(
+          l.pool_.get_allocator())) {
+  end_ = create_end();
   this->copy(l);
 }
 
-template <typename value_type>
-list<value_type>::list(list&& l)
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(list&& l)
     : head_(nullptr), tail_(nullptr), end_(nullptr), size_(0) {
+  // l keeps a fresh sentinel so that it stays usable after the move.
+  end_ = create_end();
+  change_end();
   swap(l);
 }
 
-template <typename value_type>
-list<value_type>::~list() {
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::~list() {
   clear();
-  delete end_;
+  destroy_end();
 }
 
-template <typename value_type>
-list<value_type>& list<value_type>::operator=(list&& l) {
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>& list<value_type, Allocator>::operator=(list&& l) {
   if (this != &l) {
     clear();
+    swap(l);
   }
   return *this;
 }
 
 // List Element access
-template <typename value_type>
-typename list<value_type>::const_reference list<value_type>::front() {
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::const_reference
+list<value_type, Allocator>::front() {
   return !head_ ? end_->value_ : head_->value_;
 }
 
-template <typename value_type>
-typename list<value_type>::const_reference list<value_type>::back() {
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::const_reference
+list<value_type, Allocator>::back() {
   return !tail_ ? end_->value_ : tail_->value_;
 }
 
 // List Iterators
-template <typename value_type>
-typename list<value_type>::iterator list<value_type>::begin() {
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::iterator
+list<value_type, Allocator>::begin() {
   return !head_ ? iterator(end_) : iterator(head_);
 }
 
-template <typename value_type>
-typename list<value_type>::iterator list<value_type>::end() {
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::iterator
+list<value_type, Allocator>::end() {
   return iterator(end_);
 }
 
-template <typename value_type>
-typename list<value_type>::const_iterator list<value_type>::begin() const {
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::const_iterator
+list<value_type, Allocator>::begin() const {
   return !head_ ? const_iterator(end_) : const_iterator(head_);
 }
 
-template <typename value_type>
-typename list<value_type>::const_iterator list<value_type>::end() const {
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::const_iterator
+list<value_type, Allocator>::end() const {
   return const_iterator(end_);
 }
 
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::allocator_type
+list<value_type, Allocator>::get_allocator() const {
+  return allocator_type(pool_.get_allocator());
+}
+
 // List Capacity
-template <typename value_type>
-bool list<value_type>::empty() {
+template <typename value_type, typename Allocator>
+bool list<value_type, Allocator>::empty() {
   return size_ == 0;
 }
 
-template <typename value_type>
-typename list<value_type>::size_type list<value_type>::size() {
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::size_type
+list<value_type, Allocator>::size() {
   return size_;
 }
 
-template <typename value_type>
-typename list<value_type>::size_type list<value_type>::max_size() {
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::size_type
+list<value_type, Allocator>::max_size() {
   return (std::numeric_limits<size_type>::max() / sizeof(Node) / 2);
 }
 
 // List Modifiers
-template <typename value_type>
-void list<value_type>::clear() {
-  while (!empty()) {
-    pop_back();
+// Destroys the values and returns all node slabs to the allocator at once.
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::clear() {
+  Node* current = head_;
+  for (size_type i = 0; i != size_; ++i) {
+    Node* next = current->next_;
+    pool_.Destroy(current);
+    current = next;
   }
+  pool_.Release();
+  head_ = nullptr;
+  tail_ = nullptr;
+  size_ = 0;
+  change_end();
 }
 
-template <typename value_type>
-typename list<value_type>::iterator list<value_type>::insert(
-    iterator pos, const_reference value) {
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::iterator
+list<value_type, Allocator>::insert(iterator pos, const_reference value) {
+  return emplace(pos, value);
+}
+
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::iterator
+list<value_type, Allocator>::insert(iterator pos, value_type&& value) {
+  return emplace(pos, std::move(value));
+}
+
+template <typename value_type, typename Allocator>
+template <typename... Args>
+typename list<value_type, Allocator>::iterator
+list<value_type, Allocator>::emplace(iterator pos, Args&&... args) {
   Node* current = pos.ptr_;
-  Node* add = new Node(value);
+  Node* add = pool_.New(std::forward<Args>(args)...);
   if (empty()) {
     add->next_ = end_;
     add->prev_ = end_;
@@ -144,8 +197,59 @@ typename list<value_type>::iterator list<value_type>::insert(
   return iterator(add);
 }
 
-template <typename value_type>
-void list<value_type>::erase(iterator pos) {
+// Builds the new nodes into a chain of their own and links it before pos
+// in one step, so the list is touched once for all k of them. Returns the
+// first new element, or pos when there are none.
+template <typename value_type, typename Allocator>
+template <typename... Args>
+typename list<value_type, Allocator>::iterator
+list<value_type, Allocator>::insert_many(const_iterator pos,
+                                         Args&&... args) {
+  if constexpr (sizeof...(Args) == 0) {
+    return iterator(pos.ptr_);
+  } else {
+    Node* first = nullptr;
+    Node* last = nullptr;
+    auto append = [&](auto&& arg) {
+      Node* node = pool_.New(std::forward<decltype(arg)>(arg));
+      if (last) {
+        last->next_ = node;
+        node->prev_ = last;
+      } else {
+        first = node;
+      }
+      last = node;
+    };
+    try {
+      (append(std::forward<Args>(args)), ...);
+    } catch (...) {
+      while (first) {
+        Node* next = first->next_;
+        pool_.Delete(first);
+        first = next;
+      }
+      throw;
+    }
+    link_before(pos.ptr_, first, last);
+    size_ += sizeof...(Args);
+    return iterator(first);
+  }
+}
+
+template <typename value_type, typename Allocator>
+template <typename... Args>
+void list<value_type, Allocator>::insert_many_back(Args&&... args) {
+  insert_many(end(), std::forward<Args>(args)...);
+}
+
+template <typename value_type, typename Allocator>
+template <typename... Args>
+void list<value_type, Allocator>::insert_many_front(Args&&... args) {
+  insert_many(begin(), std::forward<Args>(args)...);
+}
+
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::erase(iterator pos) {
   Node* current = pos.ptr_;
   if (!empty() && current != end_) {
     if (current == head_) {
@@ -163,7 +267,7 @@ void list<value_type>::erase(iterator pos) {
     }
     current->prev_->next_ = current->next_;
     current->next_->prev_ = current->prev_;
-    delete current;
+    pool_.Delete(current);
     this->size_--;
   } else {
     throw std::invalid_argument("Invalid argument");
@@ -171,9 +275,21 @@ void list<value_type>::erase(iterator pos) {
   change_end();
 }
 
-template <typename value_type>
-void list<value_type>::push_back(const_reference value) {
-  Node* new_node = new Node(value);
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::push_back(const_reference value) {
+  emplace_back(value);
+}
+
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::push_back(value_type&& value) {
+  emplace_back(std::move(value));
+}
+
+template <typename value_type, typename Allocator>
+template <typename... Args>
+typename list<value_type, Allocator>::reference
+list<value_type, Allocator>::emplace_back(Args&&... args) {
+  Node* new_node = pool_.New(std::forward<Args>(args)...);
   if (empty()) {
     head_ = new_node;
     tail_ = new_node;
@@ -184,10 +300,11 @@ void list<value_type>::push_back(const_reference value) {
   }
   size_++;
   change_end();
+  return new_node->value_;
 }
 
-template <typename value_type>
-void list<value_type>::pop_back() {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::pop_back() {
   if (empty()) {
     throw std::out_of_range("list is empty");
   }
@@ -199,14 +316,26 @@ void list<value_type>::pop_back() {
     tail_ = last_node->prev_;
     tail_->next_ = nullptr;
   }
-  delete last_node;
+  pool_.Delete(last_node);
   size_--;
   change_end();
 }
 
-template <typename value_type>
-void list<value_type>::push_front(const_reference value) {
-  Node* new_node = new Node(value);
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::push_front(const_reference value) {
+  emplace_front(value);
+}
+
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::push_front(value_type&& value) {
+  emplace_front(std::move(value));
+}
+
+template <typename value_type, typename Allocator>
+template <typename... Args>
+typename list<value_type, Allocator>::reference
+list<value_type, Allocator>::emplace_front(Args&&... args) {
+  Node* new_node = pool_.New(std::forward<Args>(args)...);
   if (empty()) {
     head_ = new_node;
     tail_ = new_node;
@@ -217,10 +346,11 @@ void list<value_type>::push_front(const_reference value) {
   }
   size_++;
   change_end();
+  return new_node->value_;
 }
 
-template <typename value_type>
-void list<value_type>::pop_front() {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::pop_front() {
   if (empty()) {
     throw std::out_of_range("list is empty");
   }
@@ -232,80 +362,78 @@ void list<value_type>::pop_front() {
     head_ = first_node->next_;
     head_->prev_ = nullptr;
   }
-  delete first_node;
+  pool_.Delete(first_node);
   size_--;
   change_end();
 }
 
-template <typename value_type>
-void list<value_type>::swap(list& other) {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::swap(list& other) {
   using std::swap;
   swap(this->head_, other.head_);
   swap(this->tail_, other.tail_);
   swap(this->size_, other.size_);
   swap(this->end_, other.end_);
+  pool_.swap(other.pool_);
 }
 
-template <typename value_type>
-void list<value_type>::merge(list& other) {
-  if (!this->empty() && !other.empty()) {
-    iterator iter_this = this->begin();
-    iterator iter_other = other.begin();
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::merge(list& other) {
+  merge(other, std::less<value_type>());
+}
 
-    while (iter_this != this->end() && iter_other != other.end()) {
-      if (*iter_this >= *iter_other) {
-        this->insert(iter_this, *iter_other);
-        iter_other++;
-      } else {
-        iter_this++;
-      }
+// Relinks the nodes of other into this list; nothing is allocated or
+// copied and iterators into other now point into this list. On equal
+// elements this list's come first.
+template <typename value_type, typename Allocator>
+template <typename Compare>
+void list<value_type, Allocator>::merge(list& other, Compare comp) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  if (empty()) {
+    splice(end(), other);
+    return;
+  }
+  pool_.Share(other.pool_);
+  Node* a = head_;
+  Node* b = other.head_;
+  Node* a_tail = tail_;
+  Node* b_tail = other.tail_;
+  a_tail->next_ = nullptr;
+  b_tail->next_ = nullptr;
+  Node* prev = nullptr;
+  while (a && b) {
+    Node* node;
+    if (comp(b->value_, a->value_)) {
+      node = b;
+      b = b->next_;
+    } else {
+      node = a;
+      a = a->next_;
     }
-
-    while (iter_other != other.end()) {
-      this->insert(this->end(), *iter_other);
-      iter_other++;
+    node->prev_ = prev;
+    if (prev) {
+      prev->next_ = node;
+    } else {
+      head_ = node;
     }
+    prev = node;
+  }
+  // The rest of either chain is already linked, so it is attached whole.
+  Node* rest = a ? a : b;
+  prev->next_ = rest;
+  rest->prev_ = prev;
+  tail_ = a ? a_tail : b_tail;
+  change_end();
+  size_ += other.size_;
+  other.head_ = other.tail_ = nullptr;
+  other.size_ = 0;
+  other.change_end();
+}
 
-    // Обновляем iter_this в случае вставки в середину списка
-    iter_this = this->begin();
-    while (iter_this != this->end() && *iter_this < *iter_other) {
-      iter_this++;
-    }
-  } else if (this->empty() && !other.empty()) {
-    this->copy(other);
-  }
-  other.clear();
-}
-
-// template <typename value_type>
-// void list<value_type>::merge(list& other) {
-//   if (!this->empty() && !other.empty()) {
-//     iterator iter_this = this->begin();
-//     iterator iter_other = other.begin();
-//     while (iter_this != this->end()) {
-//       if (iter_other != other.end()) {
-//         if (iter_this.ptr_->value_ >= iter_other.ptr_->value_) {
-//           this->insert(iter_this, iter_other.ptr_->value_);
-//           iter_other++;
-//         } else {
-//           iter_this++;
-//         }
-//       } else {
-//         break;
-//       }
-//     }
-//     while (iter_other != other.end()) {
-//       this->insert(iter_this, iter_other.ptr_->value_);
-//       iter_other++;
-//     }
-//   } else if (this->empty() && !other.empty()) {
-//     this->copy(other);
-//   }
-//   other.clear();
-// }
-
-template <typename value_type>
-void list<value_type>::reverse() {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::reverse() {
   if (!empty()) {
     size_type step = 0;
     for (iterator it = begin(); step <= size(); ++it) {
@@ -316,45 +444,123 @@ void list<value_type>::reverse() {
   }
 }
 
-template <typename value_type>
-void list<value_type>::unique() {
-  if (!empty()) {
-    for (iterator it = this->begin(); it != this->end(); it++) {
-      if (it.ptr_->value_ == it.ptr_->prev_->value_) {
-        iterator del_it = it;
-        --it;
-        erase(del_it);
-      } else {
-        ++it;
-      }
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::unique() {
+  if (empty()) {
+    return;
+  }
+  iterator it = begin();
+  for (iterator next = it + 1; next != end(); next = it + 1) {
+    if (it.ptr_->value_ == next.ptr_->value_) {
+      erase(next);
+    } else {
+      it = next;
     }
   }
 }
 
-template <typename value_type>
-void list<value_type>::splice(const_iterator pos, list& other) {
-  if (!other.empty()) {
-    for (iterator it = other.begin(); it != other.end(); ++it) {
-      this->insert(pos, *it);
+// The splice overloads move nodes between lists by relinking them, so
+// they never allocate or copy and iterators to the moved elements stay
+// valid. Splicing a whole list is O(1); the range overload walks the range
+// once to count it unless both lists are the same.
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::splice(const_iterator pos, list& other) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  pool_.Share(other.pool_);
+  Node* first = other.head_;
+  Node* last = other.tail_;
+  size_type count = other.size_;
+  other.unlink(first, last);
+  other.size_ = 0;
+  link_before(pos.ptr_, first, last);
+  size_ += count;
+}
+
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::splice(const_iterator pos, list& other,
+                                         const_iterator it) {
+  Node* node = it.ptr_;
+  if (node == pos.ptr_ || node->next_ == pos.ptr_) {
+    return;
+  }
+  pool_.Share(other.pool_);
+  other.unlink(node, node);
+  --other.size_;
+  link_before(pos.ptr_, node, node);
+  ++size_;
+}
+
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::splice(const_iterator pos, list& other,
+                                         const_iterator first,
+                                         const_iterator last) {
+  if (first.ptr_ == last.ptr_) {
+    return;
+  }
+  Node* head = first.ptr_;
+  Node* tail = last.ptr_->prev_;
+  if (this != &other) {
+    size_type count = 1;
+    for (Node* node = head; node != tail; node = node->next_) {
+      ++count;
     }
-    other.clear();
+    pool_.Share(other.pool_);
+    other.size_ -= count;
+    size_ += count;
   }
+  other.unlink(head, tail);
+  link_before(pos.ptr_, head, tail);
+}
+
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::sort() {
+  sort(std::less<value_type>());
 }
 
-template <typename value_type>
-void list<value_type>::sort() {
-  if (size_ > 1) {
-    quick_sort(begin(), --end());
+// Bottom-up merge sort over the next_ links. bins[i] holds a sorted run of
+// 2^i nodes; each new node is carried up through the occupied bins like a
+// binary counter. Only links change, so iterators stay valid and values
+// are never copied. Earlier runs are always the first argument of
+// merge_chains, which keeps equal elements in their original order.
+template <typename value_type, typename Allocator>
+template <typename Compare>
+void list<value_type, Allocator>::sort(Compare comp) {
+  if (size_ < 2) {
+    return;
+  }
+  Node* bins[std::numeric_limits<size_type>::digits] = {};
+  std::size_t used = 0;
+  tail_->next_ = nullptr;
+  for (Node* node = head_; node;) {
+    Node* carry = node;
+    node = node->next_;
+    carry->next_ = nullptr;
+    std::size_t i = 0;
+    for (; bins[i]; ++i) {
+      carry = merge_chains(bins[i], carry, comp);
+      bins[i] = nullptr;
+    }
+    bins[i] = carry;
+    if (i == used) ++used;
+  }
+  Node* result = nullptr;
+  for (std::size_t i = 0; i != used; ++i) {
+    if (bins[i]) result = merge_chains(bins[i], result, comp);
   }
+  relink(result);
 }
 
 // Support
-template <typename value_type>
-void list<value_type>::change_end() {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::change_end() {
   if (end_) {
     end_->next_ = head_;
     end_->prev_ = tail_;
-    end_->value_ = size();
+    if constexpr (std::is_arithmetic_v<value_type>) {
+      end_->value_ = size();
+    }
     if (head_) {
       head_->prev_ = end_;
     }
@@ -364,36 +570,115 @@ void list<value_type>::change_end() {
   }
 }
 
-template <typename value_type>
-void list<value_type>::quick_sort(iterator first, iterator last) {
-  if (first == last || first == end_ || last == end_ || first == tail_) {
-    return;
+// The sentinel lives outside the pool so that clear() can drop every slab.
+// Like libstdc++, it keeps the element count in its value for arithmetic
+// types; other types only need to be default constructible for it.
+template <typename value_type, typename Allocator>
+typename list<value_type, Allocator>::Node*
+list<value_type, Allocator>::create_end() {
+  node_allocator alloc(pool_.get_allocator());
+  Node* node = node_traits::allocate(alloc, 1);
+  try {
+    if constexpr (std::is_arithmetic_v<value_type>) {
+      node_traits::construct(alloc, node, size_);
+    } else {
+      node_traits::construct(alloc, node);
+    }
+  } catch (...) {
+    node_traits::deallocate(alloc, node, 1);
+    throw;
   }
-  iterator pivot = partition(first, last);
-  quick_sort(first, --pivot);
-  quick_sort(++pivot, last);
+  return node;
 }
 
-template <typename value_type>
-typename list<value_type>::iterator list<value_type>::partition(iterator first,
-                                                                iterator last) {
-  value_type pivot_value = last.ptr_->value_;
-  iterator i = first;
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::destroy_end() {
+  if (end_) {
+    node_allocator alloc(pool_.get_allocator());
+    node_traits::destroy(alloc, end_);
+    node_traits::deallocate(alloc, end_, 1);
+    end_ = nullptr;
+  }
+}
 
-  for (iterator j = first; j != last; ++j) {
-    if (j.ptr_->value_ <= pivot_value) {
-      std::swap(i.ptr_->value_, j.ptr_->value_);
-      i++;
+// Merges two null-terminated chains, taking from b only when it is
+// strictly less, and returns the head of the result.
+template <typename value_type, typename Allocator>
+template <typename Compare>
+typename list<value_type, Allocator>::Node*
+list<value_type, Allocator>::merge_chains(Node* a, Node* b, Compare& comp) {
+  Node* head = nullptr;
+  Node** link = &head;
+  while (a && b) {
+    if (comp(b->value_, a->value_)) {
+      *link = b;
+      b = b->next_;
+    } else {
+      *link = a;
+      a = a->next_;
     }
+    link = &(*link)->next_;
+  }
+  *link = a ? a : b;
+  return head;
+}
+
+// Links the chain first..last in front of pos, which may be end_.
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::link_before(Node* pos, Node* first,
+                                              Node* last) {
+  Node* next = pos == end_ ? nullptr : pos;
+  Node* prev = next ? next->prev_ : tail_;
+  if (prev == end_) prev = nullptr;
+  first->prev_ = prev;
+  last->next_ = next;
+  if (prev) {
+    prev->next_ = first;
+  } else {
+    head_ = first;
+  }
+  if (next) {
+    next->prev_ = last;
+  } else {
+    tail_ = last;
   }
+  change_end();
+}
 
-  std::swap(i.ptr_->value_, last.ptr_->value_);
+// Cuts first..last out of this list without touching the nodes' own
+// outer links or size_.
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::unlink(Node* first, Node* last) {
+  Node* prev = first->prev_ == end_ ? nullptr : first->prev_;
+  Node* next = last->next_ == end_ ? nullptr : last->next_;
+  if (prev) {
+    prev->next_ = next;
+  } else {
+    head_ = next;
+  }
+  if (next) {
+    next->prev_ = prev;
+  } else {
+    tail_ = prev;
+  }
+  change_end();
+}
 
-  return i;
+// Rebuilds prev_ links, head_ and tail_ from a null-terminated chain.
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::relink(Node* first) {
+  Node* prev = end_;
+  for (Node* node = first; node; node = node->next_) {
+    node->prev_ = prev;
+    prev = node;
+  }
+  head_ = first;
+  tail_ = first ? prev : nullptr;
+  change_end();
 }
 
-template <typename value_type>
-void list<value_type>::print_list() {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::print_list() {
   std::cout << "[";
   for (iterator it = begin(); it != end(); ++it) {
     std::cout << *it;
@@ -404,8 +689,9 @@ void list<value_type>::print_list() {
   std::cout << "]\n";
 }
 
-template <typename value_type>
-void list<value_type>::copy(const list& l) {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::copy(const list& l) {
+  pool_.Reserve(l.size_);
   Node* current = l.head_;
   for (size_type i = 0; i != l.size_; i++) {
     push_back(current->value_);
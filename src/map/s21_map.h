@@ -1,5 +1,170 @@
 #ifndef S21_MAP_H
 #define S21_MAP_H
 
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
-#endif // !S21_MAP_H
+#include "../tree/s21_tree.h"
+
+namespace s21 {
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+
+  // Every comparison looks at the key only; the mapped value is never read
+  // during a search.
+  struct KeyOfValue {
+    static const Key &KeyOf(const value_type &value) { return value.first; }
+  };
+
+ private:
+  using Tree = BinaryTree<Key, value_type, KeyOfValue, Compare, Allocator>;
+  template <typename K>
+  using Transparent = typename Tree::template EnableIfTransparent<K>;
+
+ public:
+  using iterator = typename Tree::iterator;
+  using const_iterator = typename Tree::const_iterator;
+  map() : tree_() {}
+  explicit map(const Allocator &alloc) : tree_(alloc) {}
+  explicit map(const Compare &comp, const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {}
+  map(std::initializer_list<value_type> const &items)
+      : map(items.begin(), items.end()) {}
+  // Sorted input is linked into a balanced tree in O(n).
+  template <typename InputIt>
+  map(InputIt first, InputIt last, const Compare &comp = Compare(),
+      const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.InsertRange(first, last, false);
+  }
+  map(const map &m) : tree_(m.tree_) {}
+  map(map &&m) : tree_(std::move(m.tree_)) {}
+  ~map() {}
+  map &operator=(map &&m) {
+    tree_ = std::move(m.tree_);
+    return *this;
+  }
+  // element access
+  T &at(const Key &key) {
+    iterator node = tree_.FindNum(key);
+    if (node == end()) {
+      throw std::out_of_range("key not found");
+    }
+    return node->second;
+  }
+  const T &at(const Key &key) const {
+    iterator node = tree_.FindNum(key);
+    if (node == end()) {
+      throw std::out_of_range("key not found");
+    }
+    return node->second;
+  }
+  T &operator[](const Key &key) { return tree_.TryEmplace(key).first->second; }
+  T &operator[](Key &&key) {
+    return tree_.TryEmplace(std::move(key)).first->second;
+  }
+  // iterators
+  iterator begin() const noexcept { return tree_.begin(); }
+  iterator end() const noexcept { return tree_.end(); }
+  // capacity
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare key_comp() const { return tree_.key_comp(); }
+  // modifiers
+  void clear() noexcept { tree_.clear(); }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_.InsertBool(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.InsertBool(std::move(value));
+  }
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return tree_.TryEmplace(key, obj);
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    return tree_.InsertOrAssign(key, std::forward<M>(obj));
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&obj) {
+    return tree_.InsertOrAssign(std::move(key), std::forward<M>(obj));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return tree_.TryEmplace(key, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return tree_.TryEmplace(std::move(key), std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.Emplace(false, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    return tree_.EmplaceHint(hint, false, std::forward<Args>(args)...).first;
+  }
+  void erase(iterator pos) { tree_.erase(pos); }
+  void swap(map &other) { tree_.swap(other.tree_); }
+  void merge(map &other) { tree_.merge(other.tree_); }
+  // lookup
+  iterator find(const Key &key) const { return tree_.FindNum(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator find(const K &key) const {
+    return tree_.FindNum(key);
+  }
+  bool contains(const Key &key) const { return tree_.FindNum(key) != end(); }
+  template <typename K, typename = Transparent<K>>
+  bool contains(const K &key) const {
+    return tree_.FindNum(key) != end();
+  }
+  size_type count(const Key &key) const { return tree_.Count(key); }
+  template <typename K, typename = Transparent<K>>
+  size_type count(const K &key) const {
+    return tree_.Count(key);
+  }
+  iterator lower_bound(const Key &key) const { return tree_.LowerBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return tree_.LowerBound(key);
+  }
+  iterator upper_bound(const Key &key) const { return tree_.UpperBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return tree_.UpperBound(key);
+  }
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.EqualRange(key);
+  }
+  template <typename K, typename = Transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return tree_.EqualRange(key);
+  }
+
+  // One sort and one pass over the tree for all the values.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return tree_.InsertMany(false, std::forward<Args>(args)...);
+  }
+
+ private:
+  Tree tree_;
+};
+}  // namespace s21
+
+#endif  // S21_MAP_H
@@ -1,10 +1,14 @@
 #ifndef S21_MULTISET_
 #define S21_MULTISET_
 
+#include <functional>
+#include <vector>
+
 #include "../tree/s21_tree.h"
 
 namespace s21 {
-template <class Key>
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
 class multiset {
  public:
   using key_type = Key;
@@ -12,27 +16,35 @@ class multiset {
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+  using value_compare = Compare;
 
-  struct Comparator {
-    static bool Equality(value_type node_value, Key value) {
-      return node_value == value;
-    }
-    static bool NotEquality(value_type node_value, Key value) {
-      return node_value != value;
-    }
-    static bool Less(value_type node_value, Key value) {
-      return value < node_value;
-    }
+  struct KeyOfValue {
+    static const Key &KeyOf(const value_type &value) { return value; }
   };
 
-  using iterator = typename BinaryTree<Key, Key, Comparator>::iterator;
-  using const_iterator =
-      typename BinaryTree<Key, Key, Comparator>::const_iterator;
+ private:
+  using Tree = BinaryTree<Key, Key, KeyOfValue, Compare, Allocator>;
+  template <typename K>
+  using Transparent = typename Tree::template EnableIfTransparent<K>;
+
+ public:
+  using iterator = typename Tree::iterator;
+  using const_iterator = typename Tree::const_iterator;
   multiset() : tree_(){};
-  multiset(std::initializer_list<value_type> const &items) {
-    for (auto element : items) {
-      tree_.Insert(element, true);
-    }
+  explicit multiset(const Allocator &alloc) : tree_(alloc) {}
+  explicit multiset(const Compare &comp,
+                    const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {}
+  multiset(std::initializer_list<value_type> const &items)
+      : multiset(items.begin(), items.end()) {}
+  // Sorted input is linked into a balanced tree in O(n).
+  template <typename InputIt>
+  multiset(InputIt first, InputIt last, const Compare &comp = Compare(),
+           const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.InsertRange(first, last, true);
   }
   multiset(const multiset &ms) : tree_(ms.tree_){};
   multiset(multiset &&ms) : tree_(std::move(ms.tree_)){};
@@ -48,49 +60,97 @@ class multiset {
   bool empty() const noexcept { return tree_.empty(); };
   size_type size() const noexcept { return tree_.size(); };
   size_type max_size() const noexcept { return tree_.max_size(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare key_comp() const { return tree_.key_comp(); }
+  value_compare value_comp() const { return tree_.key_comp(); }
   // modifiers
   void clear() noexcept { tree_.clear(); };
   std::pair<iterator, bool> insert(const value_type &value) {
     return tree_.InsertBool(value, true);
   }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.InsertBool(std::move(value), true);
+  }
+  // Sorted input is only checked, not sorted again.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    tree_.InsertRange(first, last, true);
+  }
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return tree_.Emplace(true, std::forward<Args>(args)...).first;
+  }
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    return tree_.EmplaceHint(hint, true, std::forward<Args>(args)...).first;
+  }
   void erase(iterator pos) { tree_.erase(pos); }
   void swap(multiset &other) { tree_.swap(other.tree_); };
-  void merge(multiset &other) { tree_.merge(other.tree_); };
+  void merge(multiset &other) { tree_.merge(other.tree_, true); };
   // lookup
-  size_type count(const Key &key) {
-    size_type counter = 0;
-    tree_.counter(tree_, counter, key);
-    return counter;
+  iterator find(const Key &key) const { return tree_.FindNum(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator find(const K &key) const {
+    return tree_.FindNum(key);
   }
-  iterator find(const Key &key) { return tree_.FindNum(key); }
-  bool contains(const Key &key) {
-    iterator node = tree_.FindNum(key);
-    iterator null;
-    return node != null;
+  bool contains(const Key &key) const { return tree_.FindNum(key) != end(); }
+  template <typename K, typename = Transparent<K>>
+  bool contains(const K &key) const {
+    return tree_.FindNum(key) != end();
   }
-
-  iterator lower_bound(const Key &key) {
-    return tree_.FindNumByIter(key, true);
+  size_type count(const Key &key) const { return tree_.Count(key); }
+  template <typename K, typename = Transparent<K>>
+  size_type count(const K &key) const {
+    return tree_.Count(key);
   }
-  iterator upper_bound(const Key &key) {
-    return tree_.FindNumByIter(key, false, true);
+  iterator lower_bound(const Key &key) const { return tree_.LowerBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return tree_.LowerBound(key);
   }
-  std::pair<iterator, iterator> equal_range(const Key &key) {
-    std::pair<iterator, iterator> result = {lower_bound(key), upper_bound(key)};
-    return result;
+  iterator upper_bound(const Key &key) const { return tree_.UpperBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return tree_.UpperBound(key);
+  }
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.EqualRange(key);
+  }
+  template <typename K, typename = Transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return tree_.EqualRange(key);
   }
 
+  // One sort and one pass over the tree for all the values.
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
-    std::vector<std::pair<iterator, bool>> vec;
-    for (const auto &arg : {args...}) {
-      vec.push_back(insert(arg));
-    }
-    return vec;
+    return tree_.InsertMany(true, std::forward<Args>(args)...);
+  }
+
+  // Linear merges of two multisets into a new one. threads > 1 (0 for one
+  // per core) splits large inputs across std::async tasks.
+  friend multiset set_union(const multiset &a, const multiset &b,
+                            size_type threads = 1) {
+    return Combine(a, b, Tree::SetOp::kUnion, threads);
+  }
+  friend multiset set_intersection(const multiset &a, const multiset &b,
+                                   size_type threads = 1) {
+    return Combine(a, b, Tree::SetOp::kIntersection, threads);
+  }
+  friend multiset set_difference(const multiset &a, const multiset &b,
+                                 size_type threads = 1) {
+    return Combine(a, b, Tree::SetOp::kDifference, threads);
   }
 
  private:
-  BinaryTree<Key, Key, Comparator> tree_;
+  static multiset Combine(const multiset &a, const multiset &b,
+                          typename Tree::SetOp op, size_type threads) {
+    multiset result(a.key_comp(), a.get_allocator());
+    result.tree_.SetAlgebra(a.tree_, b.tree_, op, threads);
+    return result;
+  }
+
+  Tree tree_;
 };
 }  // namespace s21
 
@@ -0,0 +1,155 @@
+#ifndef S21_QUEUE_H
+#define S21_QUEUE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "../allocator/s21_slot_storage.h"
+
+namespace s21 {
+
+// FIFO queue on a power-of-two ring buffer. The growable mode
+// (Capacity == 0) doubles its buffer when full and never shrinks it, so
+// push and pop do not allocate once the queue has reached its working
+// size. A non-zero Capacity keeps the slots inside the object and never
+// allocates at all; pushing into a full fixed queue throws.
+template <typename T, std::size_t Capacity = 0>
+class queue {
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "fixed queue capacity must be a power of two");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  queue() noexcept {}
+  queue(std::initializer_list<value_type> const &items) {
+    for (const auto &item : items) {
+      push(item);
+    }
+  }
+  queue(const queue &q) {
+    for (size_type i = 0; i != q.size_; ++i) {
+      push(q.at(i));
+    }
+  }
+  queue(queue &&q) noexcept(Capacity == 0) { take(q); }
+  ~queue() { release(); }
+  queue &operator=(const queue &q) {
+    if (this != &q) {
+      queue copy(q);
+      swap(copy);
+    }
+    return *this;
+  }
+  queue &operator=(queue &&q) noexcept(Capacity == 0) {
+    if (this != &q) {
+      release();
+      take(q);
+    }
+    return *this;
+  }
+
+  // element access
+  reference front() { return at(0); }
+  const_reference front() const { return at(0); }
+  reference back() { return at(size_ - 1); }
+  const_reference back() const { return at(size_ - 1); }
+
+  // capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return slots_.capacity(); }
+  bool full() const noexcept { return Capacity != 0 && size_ == Capacity; }
+
+  // modifiers
+  void push(const_reference value) { emplace(value); }
+  void push(value_type &&value) { emplace(std::move(value)); }
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    if (size_ == capacity()) {
+      if constexpr (Capacity != 0) {
+        throw std::length_error("queue is full");
+      } else {
+        // The ring is unrolled into the new block, oldest element first.
+        slots_.Grow(head_, size_, std::forward<Args>(args)...);
+        head_ = 0;
+        ++size_;
+        return back();
+      }
+    }
+    ::new (static_cast<void *>(slots() + wrap(head_ + size_)))
+        value_type(std::forward<Args>(args)...);
+    ++size_;
+    return back();
+  }
+  void pop() {
+    if (empty()) {
+      throw std::out_of_range("queue is empty");
+    }
+    slots()[head_].~value_type();
+    head_ = wrap(head_ + 1);
+    --size_;
+  }
+  void swap(queue &other) noexcept(Capacity == 0) {
+    if constexpr (Capacity == 0) {
+      slots_.swap(other.slots_);
+      std::swap(head_, other.head_);
+      std::swap(size_, other.size_);
+    } else {
+      queue tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+  }
+
+ private:
+  value_type *slots() noexcept { return slots_.get(); }
+  const value_type *slots() const noexcept { return slots_.get(); }
+  size_type wrap(size_type index) const noexcept {
+    return index & (capacity() - 1);
+  }
+  reference at(size_type i) { return slots()[wrap(head_ + i)]; }
+  const_reference at(size_type i) const { return slots()[wrap(head_ + i)]; }
+
+  void destroy_all() noexcept {
+    for (size_type i = 0; i != size_; ++i) {
+      at(i).~value_type();
+    }
+  }
+
+  void release() noexcept {
+    destroy_all();
+    if constexpr (Capacity == 0) slots_.Release();
+    head_ = 0;
+    size_ = 0;
+  }
+
+  // Leaves q empty; the growable mode steals its buffer.
+  void take(queue &q) {
+    if constexpr (Capacity == 0) {
+      slots_.swap(q.slots_);
+      head_ = q.head_;
+      size_ = q.size_;
+      q.head_ = 0;
+      q.size_ = 0;
+    } else {
+      while (!q.empty()) {
+        push(std::move(q.front()));
+        q.pop();
+      }
+    }
+  }
+
+  SlotStorage<value_type, Capacity> slots_;
+  size_type head_{0};
+  size_type size_{0};
+};
+}  // namespace s21
+
+#endif  // S21_QUEUE_H
@@ -0,0 +1,207 @@
+#ifndef S21_CONCURRENT_QUEUE_H
+#define S21_CONCURRENT_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../allocator/s21_aligned_allocator.h"
+#include "../allocator/s21_inline_storage.h"
+
+namespace s21 {
+
+// Bounded lock-free FIFO for any number of producer and consumer threads
+// (Vyukov's MPMC ring). Every slot carries a sequence number that tells
+// whose turn it is: a producer may fill the slot for position pos when the
+// number equals pos, a consumer may empty it when it equals pos + 1. A
+// thread claims a position with one CAS on the shared tail or head and then
+// owns its slot outright, so threads working on different slots never
+// wait for each other. try_push and try_pop fail rather than block when
+// the queue is full or empty.
+//
+// A value whose construction may throw is built before a position is
+// claimed and moved into the slot afterwards, so T must move without
+// throwing. try_push of an rvalue claims first and moves straight into the
+// slot, so a push that fails on a full queue leaves its argument alone.
+template <typename T>
+class concurrent_queue {
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                    std::is_nothrow_move_assignable_v<T>,
+                "a claimed slot cannot be given back: T must move nothrow");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  // The capacity is rounded up to a power of two, at least 2.
+  explicit concurrent_queue(size_type capacity) {
+    if (capacity > max_size()) {
+      throw std::length_error("concurrent_queue too large");
+    }
+    size_type size = 2;
+    while (size < capacity) size *= 2;
+    slots_ = SlotAllocator().allocate(size);
+    for (size_type i = 0; i != size; ++i) {
+      ::new (static_cast<void *>(slots_ + i)) Slot(i);
+    }
+    mask_ = size - 1;
+  }
+  concurrent_queue(const concurrent_queue &) = delete;
+  concurrent_queue &operator=(const concurrent_queue &) = delete;
+  // Needs no other thread to be using the queue.
+  ~concurrent_queue() {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    for (size_type pos = head_.load(std::memory_order_relaxed); pos != tail;
+         ++pos) {
+      Value(pos)->~value_type();
+    }
+    for (size_type i = 0; i <= mask_; ++i) slots_[i].~Slot();
+    SlotAllocator().deallocate(slots_, mask_ + 1);
+  }
+
+  size_type capacity() const noexcept { return mask_ + 1; }
+  size_type max_size() const noexcept {
+    return (std::numeric_limits<size_type>::max() / 2 + 1) / sizeof(Slot);
+  }
+  // A snapshot that other threads may already have changed.
+  size_type size_approx() const noexcept {
+    size_type head = head_.load(std::memory_order_relaxed);
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool try_push(const value_type &value) {
+    if constexpr (std::is_nothrow_copy_constructible_v<value_type>) {
+      return PushInPlace(value);
+    } else {
+      return try_emplace(value);
+    }
+  }
+  bool try_push(value_type &&value) { return PushInPlace(std::move(value)); }
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    size_type pos;
+    if (Claim(tail_, 0, 1, pos) == 0) return false;
+    ::new (static_cast<void *>(Value(pos))) value_type(std::move(value));
+    Publish(pos, pos + 1);
+    return true;
+  }
+
+  bool try_pop(value_type &out) {
+    size_type pos;
+    if (Claim(head_, 1, 1, pos) == 0) return false;
+    Take(pos, out);
+    return true;
+  }
+
+  // Pushes the longest prefix of [first, last) that fits with a single
+  // claim and returns its length. The values are built in claimed slots,
+  // so building one must not throw: pass move iterators for types whose
+  // copy may.
+  template <typename ForwardIt>
+  size_type try_push_batch(ForwardIt first, ForwardIt last) {
+    static_assert(
+        std::is_nothrow_constructible_v<
+            value_type, typename std::iterator_traits<ForwardIt>::reference>,
+        "batch values are built in claimed slots; pass move iterators");
+    size_type wanted = static_cast<size_type>(std::distance(first, last));
+    size_type pos;
+    size_type count = Claim(tail_, 0, wanted, pos);
+    for (size_type i = 0; i != count; ++i, ++first) {
+      ::new (static_cast<void *>(Value(pos + i))) value_type(*first);
+      Publish(pos + i, pos + i + 1);
+    }
+    return count;
+  }
+
+  // Pops up to max values with a single claim, moving them to out[0],
+  // out[1], ..., and returns how many there were.
+  size_type try_pop_batch(value_type *out, size_type max) {
+    size_type pos;
+    size_type count = Claim(head_, 1, max, pos);
+    for (size_type i = 0; i != count; ++i) Take(pos + i, out[i]);
+    return count;
+  }
+
+ private:
+  // Keeps the producers' and the consumers' counters off each other's
+  // cache line, and both off the read-only fields.
+  static constexpr std::size_t kCacheLine = 64;
+
+  struct Slot {
+    explicit Slot(size_type pos) : sequence(pos) {}
+    std::atomic<size_type> sequence;
+    InlineStorage<value_type, 1> storage;
+  };
+  using SlotAllocator = aligned_allocator<Slot, kCacheLine>;
+
+  // Only for a construction that cannot throw: the slot is claimed first.
+  template <typename V>
+  bool PushInPlace(V &&value) noexcept {
+    size_type pos;
+    if (Claim(tail_, 0, 1, pos) == 0) return false;
+    ::new (static_cast<void *>(Value(pos))) value_type(std::forward<V>(value));
+    Publish(pos, pos + 1);
+    return true;
+  }
+
+  value_type *Value(size_type pos) const noexcept {
+    return slots_[pos & mask_].storage.get();
+  }
+
+  // Claims up to max consecutive positions from counter (the tail for
+  // producers with lag 0, the head for consumers with lag 1) whose slots
+  // are ready, and returns how many it got, starting at pos. A slot is
+  // ready when its sequence is its position plus lag; one behind means the
+  // queue is full (or empty) there.
+  size_type Claim(std::atomic<size_type> &counter, size_type lag,
+                  size_type max, size_type &pos) noexcept {
+    pos = counter.load(std::memory_order_relaxed);
+    if (max == 0) return 0;
+    for (;;) {
+      size_type count = 0;
+      std::intptr_t diff = 0;
+      for (; count != max && count <= mask_; ++count) {
+        size_type sequence = slots_[(pos + count) & mask_].sequence.load(
+            std::memory_order_acquire);
+        diff = static_cast<std::intptr_t>(sequence - (pos + count + lag));
+        if (diff != 0) break;
+      }
+      if (count == 0) {
+        if (diff < 0) return 0;
+        pos = counter.load(std::memory_order_relaxed);  // pos was taken
+      } else if (counter.compare_exchange_weak(pos, pos + count,
+                                               std::memory_order_relaxed)) {
+        return count;
+      }
+    }
+  }
+
+  void Take(size_type pos, value_type &out) noexcept {
+    value_type *value = Value(pos);
+    out = std::move(*value);
+    value->~value_type();
+    Publish(pos, pos + mask_ + 1);
+  }
+
+  // Hands the slot of pos to whoever waits for sequence next.
+  void Publish(size_type pos, size_type sequence) noexcept {
+    slots_[pos & mask_].sequence.store(sequence, std::memory_order_release);
+  }
+
+  alignas(kCacheLine) std::atomic<size_type> tail_{0};
+  alignas(kCacheLine) std::atomic<size_type> head_{0};
+  alignas(kCacheLine) Slot *slots_{nullptr};
+  size_type mask_{0};
+};
+
+}  // namespace s21
+
+#endif  // S21_CONCURRENT_QUEUE_H
@@ -1,14 +1,25 @@
 #ifndef S21_CONTAINERS_H
 #define S21_CONTAINERS_H
 
+#include "btree_map/s21_btree_map.h"
+#include "btree_set/s21_btree_set.h"
+#include "flat_map/s21_flat_map.h"
+#include "flat_set/s21_flat_set.h"
+#include "list/s21_intrusive_list.h"
 #include "list/s21_list.h"
-// #include "map/s21_map.h"
-// #include "queue/queue.h"
+#include "map/s21_map.h"
+#include "queue/queue.h"
+#include "queue/s21_concurrent_queue.h"
+#include "set/s21_intrusive_set.h"
 #include "set/s21_set.h"
-// #include "stack/s21_stack.h"
-// #include "vector/s21_vector.h"
+#include "stack/s21_stack.h"
+#include "stack/s21_work_stealing_deque.h"
+#include "vector/s21_vector.h"
 #include "multiset/s21_multiset.h"
 #include "tree/s21_tree.h"
+#include "unordered_map/s21_unordered_map.h"
+#include "unordered_set/s21_unordered_set.h"
+#include "unrolled_list/s21_unrolled_list.h"
 // #include "array/s21_array.h"
 
 #endif // S21_CONTAINERS_H
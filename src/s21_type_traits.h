@@ -0,0 +1,18 @@
+#ifndef S21_TYPE_TRAITS_H
+#define S21_TYPE_TRAITS_H
+
+#include <type_traits>
+
+namespace s21 {
+
+// Whether a comparator, hasher or key equality declares is_transparent, as
+// std::less<> does, and so takes other types than the key directly.
+template <typename T, typename = void>
+struct IsTransparent : std::false_type {};
+template <typename T>
+struct IsTransparent<T, std::void_t<typename T::is_transparent>>
+    : std::true_type {};
+
+}  // namespace s21
+
+#endif  // S21_TYPE_TRAITS_H
@@ -0,0 +1,335 @@
+#ifndef S21_INTRUSIVE_SET_H
+#define S21_INTRUSIVE_SET_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../tree/s21_rb_tree.h"
+
+namespace s21 {
+
+template <typename T, typename Compare, typename Tag>
+class intrusive_set;
+
+// The red-black links an intrusive_set threads through an object. As with
+// list_hook, a type derives from one hook per set it can be in at the same
+// time, told apart by Tag, and a copy starts out in no set.
+template <typename Tag = void>
+class set_hook : private RbNode {
+ public:
+  set_hook() = default;
+  set_hook(const set_hook &) noexcept : RbNode() {}
+  set_hook &operator=(const set_hook &) noexcept { return *this; }
+
+  bool is_linked() const noexcept { return parent != nullptr; }
+
+ private:
+  template <typename, typename, typename>
+  friend class intrusive_set;
+};
+
+// An ordered set of objects that live elsewhere, for example in a pool,
+// run by the same red-black code as set. Insert and erase relink the hook
+// inside the object and never allocate or copy. Compare orders the
+// objects themselves; lookups take anything it can compare with them, such
+// as a bare id. An object must not change its key or die while linked;
+// clearing or destroying the set leaves every object unlinked.
+template <typename T, typename Compare = std::less<T>, typename Tag = void>
+class intrusive_set {
+  using Hook = set_hook<Tag>;
+  static_assert(std::is_base_of_v<Hook, T>, "T must derive from set_hook");
+
+ public:
+  using key_type = T;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+  // iterator converts to const_iterator, which only hands out const
+  // references.
+  template <bool kConst>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<kConst, const T *, T *>;
+    using reference = std::conditional_t<kConst, const T &, T &>;
+
+    Iterator() = default;
+    template <bool kOther, typename = std::enable_if_t<kConst && !kOther>>
+    Iterator(const Iterator<kOther> &other) : node_(other.node_) {}
+    reference operator*() const { return *ValueOf(node_); }
+    pointer operator->() const { return ValueOf(node_); }
+    Iterator &operator++() {
+      node_ = RbTree::Next(node_);
+      return *this;
+    }
+    Iterator &operator--() {
+      node_ = RbTree::Prev(node_);
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator it(*this);
+      ++(*this);
+      return it;
+    }
+    Iterator operator--(int) {
+      Iterator it(*this);
+      --(*this);
+      return it;
+    }
+    template <bool kOther>
+    bool operator==(const Iterator<kOther> &other) const {
+      return node_ == other.node_;
+    }
+    template <bool kOther>
+    bool operator!=(const Iterator<kOther> &other) const {
+      return node_ != other.node_;
+    }
+
+   private:
+    friend class intrusive_set;
+    template <bool>
+    friend class Iterator;
+    explicit Iterator(RbNode *node) : node_(node) {}
+
+    RbNode *node_{nullptr};
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  intrusive_set() = default;
+  explicit intrusive_set(const Compare &comp) : comp_(comp) {}
+  intrusive_set(const intrusive_set &) = delete;
+  intrusive_set(intrusive_set &&other) noexcept : comp_(other.comp_) {
+    swap(other);
+  }
+  ~intrusive_set() { clear(); }
+  intrusive_set &operator=(const intrusive_set &) = delete;
+  intrusive_set &operator=(intrusive_set &&other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // iterators
+  iterator begin() noexcept { return iterator(header_.left); }
+  const_iterator begin() const noexcept {
+    return const_iterator(header_.left);
+  }
+  iterator end() noexcept { return iterator(Header()); }
+  const_iterator end() const noexcept { return const_iterator(Header()); }
+  // The position of an object linked into this set.
+  iterator iterator_to(reference value) noexcept {
+    return iterator(NodeOf(&value));
+  }
+  const_iterator iterator_to(const_reference value) const noexcept {
+    return const_iterator(NodeOf(&const_cast<T &>(value)));
+  }
+
+  // capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  // modifiers
+  // Unlinks every object, in O(n). Leaves are cut off as the walk climbs
+  // back, so no stack is needed.
+  void clear() noexcept {
+    RbNode *node = header_.parent;
+    while (node != nullptr && node != &header_) {
+      if (node->left != nullptr) {
+        node = node->left;
+      } else if (node->right != nullptr) {
+        node = node->right;
+      } else {
+        RbNode *parent = node->parent;
+        if (parent != &header_) {
+          (parent->left == node ? parent->left : parent->right) = nullptr;
+        }
+        node->parent = nullptr;
+        node = parent;
+      }
+    }
+    ResetHeader();
+    size_ = 0;
+  }
+
+  // Links value unless an equal object is already in the set, which is
+  // then returned instead. value must not be in a set of this Tag yet.
+  std::pair<iterator, bool> insert(reference value) {
+    RbNode *node = NodeOf(&value);
+    if (static_cast<Hook *>(&value)->is_linked()) {
+      throw std::invalid_argument("value is already in a set");
+    }
+    RbNode *parent = Header();
+    bool to_left = false;
+    for (RbNode *slot = header_.parent; slot != nullptr;) {
+      parent = slot;
+      if (comp_(value, *ValueOf(slot))) {
+        to_left = true;
+        slot = slot->left;
+      } else if (comp_(*ValueOf(slot), value)) {
+        to_left = false;
+        slot = slot->right;
+      } else {
+        return {iterator(slot), false};
+      }
+    }
+    RbTree::Link(node, parent, to_left, header_);
+    ++size_;
+    return {iterator(node), true};
+  }
+
+  // Unlinks the object at pos and returns the position after it.
+  iterator erase(const_iterator pos) {
+    if (pos.node_ == nullptr || pos.node_ == &header_) {
+      throw std::invalid_argument("wrong argument");
+    }
+    iterator next(RbTree::Next(pos.node_));
+    RbTree::Unlink(pos.node_, header_);
+    pos.node_->parent = nullptr;
+    --size_;
+    return next;
+  }
+  // Keeps an iterator argument away from the erase by key below.
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+  template <typename K>
+  size_type erase(const K &key) {
+    iterator it = find(key);
+    if (it == end()) return 0;
+    erase(it);
+    return 1;
+  }
+
+  void swap(intrusive_set &other) noexcept {
+    std::swap(header_.parent, other.header_.parent);
+    std::swap(header_.left, other.header_.left);
+    std::swap(header_.right, other.header_.right);
+    std::swap(size_, other.size_);
+    std::swap(comp_, other.comp_);
+    AdoptNodes();
+    other.AdoptNodes();
+  }
+
+  // lookup
+  template <typename K>
+  iterator find(const K &key) {
+    return iterator(FindNode(key));
+  }
+  template <typename K>
+  const_iterator find(const K &key) const {
+    return const_iterator(FindNode(key));
+  }
+  template <typename K>
+  bool contains(const K &key) const {
+    return FindNode(key) != &header_;
+  }
+  template <typename K>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+  // First object not less than key.
+  template <typename K>
+  iterator lower_bound(const K &key) {
+    return iterator(LowerBound(key));
+  }
+  template <typename K>
+  const_iterator lower_bound(const K &key) const {
+    return const_iterator(LowerBound(key));
+  }
+  // First object greater than key.
+  template <typename K>
+  iterator upper_bound(const K &key) {
+    return iterator(UpperBound(key));
+  }
+  template <typename K>
+  const_iterator upper_bound(const K &key) const {
+    return const_iterator(UpperBound(key));
+  }
+
+  key_compare key_comp() const { return comp_; }
+
+ private:
+  static RbNode *NodeOf(T *value) noexcept {
+    return static_cast<RbNode *>(static_cast<Hook *>(value));
+  }
+  static T *ValueOf(RbNode *node) noexcept {
+    return static_cast<T *>(static_cast<Hook *>(node));
+  }
+
+  RbNode *Header() const { return const_cast<RbNode *>(&header_); }
+
+  template <typename K>
+  RbNode *FindNode(const K &key) const {
+    RbNode *node = header_.parent;
+    while (node != nullptr) {
+      if (comp_(key, *ValueOf(node))) {
+        node = node->left;
+      } else if (comp_(*ValueOf(node), key)) {
+        node = node->right;
+      } else {
+        return node;
+      }
+    }
+    return Header();
+  }
+  template <typename K>
+  RbNode *LowerBound(const K &key) const {
+    RbNode *node = header_.parent;
+    RbNode *result = Header();
+    while (node != nullptr) {
+      if (comp_(*ValueOf(node), key)) {
+        node = node->right;
+      } else {
+        result = node;
+        node = node->left;
+      }
+    }
+    return result;
+  }
+  template <typename K>
+  RbNode *UpperBound(const K &key) const {
+    RbNode *node = header_.parent;
+    RbNode *result = Header();
+    while (node != nullptr) {
+      if (comp_(key, *ValueOf(node))) {
+        result = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return result;
+  }
+
+  void ResetHeader() noexcept {
+    header_.parent = nullptr;
+    header_.left = header_.right = &header_;
+  }
+
+  // Points the root back at this header after the links moved here.
+  void AdoptNodes() noexcept {
+    if (header_.parent != nullptr) {
+      header_.parent->parent = &header_;
+    } else {
+      ResetHeader();
+    }
+  }
+
+  RbNode header_{&header_, &header_, nullptr, RbNode::Color::kRed};
+  size_type size_{0};
+  Compare comp_;
+};
+
+}  // namespace s21
+
+#endif  // S21_INTRUSIVE_SET_H
@@ -1,10 +1,14 @@
 #ifndef S21_SET_
 #define S21_SET_
 
+#include <functional>
+#include <vector>
+
 #include "../tree/s21_tree.h"
 
 namespace s21 {
-template <class Key>
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
 class set {
  public:
   using key_type = Key;
@@ -12,27 +16,34 @@ class set {
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+  using value_compare = Compare;
 
-  struct Comparator {
-    static bool Equality(value_type node_value, Key value) {
-      return node_value == value;
-    }
-    static bool NotEquality(value_type node_value, Key value) {
-      return node_value != value;
-    }
-    static bool Less(value_type node_value, Key value) {
-      return value < node_value;
-    }
+  struct KeyOfValue {
+    static const Key &KeyOf(const value_type &value) { return value; }
   };
 
-  using iterator = typename BinaryTree<Key, Key, Comparator>::iterator;
-  using const_iterator =
-      typename BinaryTree<Key, Key, Comparator>::const_iterator;
+ private:
+  using Tree = BinaryTree<Key, Key, KeyOfValue, Compare, Allocator>;
+  template <typename K>
+  using Transparent = typename Tree::template EnableIfTransparent<K>;
+
+ public:
+  using iterator = typename Tree::iterator;
+  using const_iterator = typename Tree::const_iterator;
   set() : tree_() {}
-  set(std::initializer_list<value_type> const &items) {
-    for (auto element : items) {
-      tree_.Insert(element);
-    }
+  explicit set(const Allocator &alloc) : tree_(alloc) {}
+  explicit set(const Compare &comp, const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {}
+  set(std::initializer_list<value_type> const &items)
+      : set(items.begin(), items.end()) {}
+  // Sorted input is linked into a balanced tree in O(n).
+  template <typename InputIt>
+  set(InputIt first, InputIt last, const Compare &comp = Compare(),
+      const Allocator &alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.InsertRange(first, last, false);
   }
   set(const set &s) : tree_(s.tree_){};
   set(set &&s) : tree_(std::move(s.tree_)){};
@@ -46,30 +57,94 @@ class set {
   bool empty() const noexcept { return tree_.empty(); };
   size_type size() const noexcept { return tree_.size(); };
   size_type max_size() const noexcept { return tree_.max_size(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare key_comp() const { return tree_.key_comp(); }
+  value_compare value_comp() const { return tree_.key_comp(); }
   void clear() noexcept { tree_.clear(); };
   std::pair<iterator, bool> insert(const value_type &value) {
     return tree_.InsertBool(value);
   }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.InsertBool(std::move(value));
+  }
+  // Sorted input is only checked, not sorted again.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    tree_.InsertRange(first, last, false);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.Emplace(false, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    return tree_.EmplaceHint(hint, false, std::forward<Args>(args)...).first;
+  }
   void erase(iterator pos) { tree_.erase(pos); }
   void swap(set &other) { tree_.swap(other.tree_); };
   void merge(set &other) { tree_.merge(other.tree_); };
-  iterator find(const Key &key) { return tree_.FindNum(key); }
-  bool contains(const Key &key) {
-    iterator node = tree_.FindNum(key);
-    iterator null;
-    return node != null;
+  iterator find(const Key &key) const { return tree_.FindNum(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator find(const K &key) const {
+    return tree_.FindNum(key);
+  }
+  bool contains(const Key &key) const { return tree_.FindNum(key) != end(); }
+  template <typename K, typename = Transparent<K>>
+  bool contains(const K &key) const {
+    return tree_.FindNum(key) != end();
   }
+  size_type count(const Key &key) const { return tree_.Count(key); }
+  template <typename K, typename = Transparent<K>>
+  size_type count(const K &key) const {
+    return tree_.Count(key);
+  }
+  iterator lower_bound(const Key &key) const { return tree_.LowerBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return tree_.LowerBound(key);
+  }
+  iterator upper_bound(const Key &key) const { return tree_.UpperBound(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return tree_.UpperBound(key);
+  }
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.EqualRange(key);
+  }
+  template <typename K, typename = Transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return tree_.EqualRange(key);
+  }
+  // One sort and one pass over the tree for all the values.
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
-    std::vector<std::pair<iterator, bool>> vec;
-    for (const auto &arg : {args...}) {
-      vec.push_back(insert(arg));
-    }
-    return vec;
+    return tree_.InsertMany(false, std::forward<Args>(args)...);
+  }
+
+  // Linear merges of two sets into a new one. threads > 1 (0 for one
+  // per core) splits large inputs across std::async tasks.
+  friend set set_union(const set &a, const set &b,
+                       size_type threads = 1) {
+    return Combine(a, b, Tree::SetOp::kUnion, threads);
+  }
+  friend set set_intersection(const set &a, const set &b,
+                              size_type threads = 1) {
+    return Combine(a, b, Tree::SetOp::kIntersection, threads);
+  }
+  friend set set_difference(const set &a, const set &b,
+                            size_type threads = 1) {
+    return Combine(a, b, Tree::SetOp::kDifference, threads);
   }
 
  private:
-  BinaryTree<Key, Key, Comparator> tree_;
+  static set Combine(const set &a, const set &b,
+                     typename Tree::SetOp op, size_type threads) {
+    set result(a.key_comp(), a.get_allocator());
+    result.tree_.SetAlgebra(a.tree_, b.tree_, op, threads);
+    return result;
+  }
+
+  Tree tree_;
 };
 }  // namespace s21
 
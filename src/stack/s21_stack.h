@@ -0,0 +1,139 @@
+#ifndef S21_STACK_H
+#define S21_STACK_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "../allocator/s21_slot_storage.h"
+
+namespace s21 {
+
+// LIFO stack on one contiguous block. The growable mode (Capacity == 0)
+// doubles the block when full and keeps it on pop, so a warmed-up stack
+// does not allocate. A non-zero Capacity stores the elements inside the
+// object and never allocates; pushing onto a full fixed stack throws.
+template <typename T, std::size_t Capacity = 0>
+class stack {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  stack() noexcept {}
+  stack(std::initializer_list<value_type> const &items) {
+    if constexpr (Capacity == 0) reserve(items.size());
+    for (const auto &item : items) {
+      push(item);
+    }
+  }
+  stack(const stack &s) {
+    if constexpr (Capacity == 0) reserve(s.size_);
+    for (size_type i = 0; i != s.size_; ++i) {
+      push(s.data()[i]);
+    }
+  }
+  stack(stack &&s) noexcept(Capacity == 0) { take(s); }
+  ~stack() { release(); }
+  stack &operator=(const stack &s) {
+    if (this != &s) {
+      stack copy(s);
+      swap(copy);
+    }
+    return *this;
+  }
+  stack &operator=(stack &&s) noexcept(Capacity == 0) {
+    if (this != &s) {
+      release();
+      take(s);
+    }
+    return *this;
+  }
+
+  // element access
+  reference top() { return data()[size_ - 1]; }
+  const_reference top() const { return data()[size_ - 1]; }
+
+  // capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return slots_.capacity(); }
+  bool full() const noexcept { return Capacity != 0 && size_ == Capacity; }
+  void reserve(size_type size) {
+    static_assert(Capacity == 0, "a fixed stack cannot be resized");
+    slots_.Reserve(size, size_);
+  }
+
+  // modifiers
+  void push(const_reference value) { emplace(value); }
+  void push(value_type &&value) { emplace(std::move(value)); }
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    if (size_ == capacity()) {
+      if constexpr (Capacity != 0) {
+        throw std::length_error("stack is full");
+      } else {
+        slots_.Grow(0, size_, std::forward<Args>(args)...);
+        return data()[size_++];
+      }
+    }
+    ::new (static_cast<void *>(data() + size_))
+        value_type(std::forward<Args>(args)...);
+    return data()[size_++];
+  }
+  void pop() {
+    if (empty()) {
+      throw std::out_of_range("stack is empty");
+    }
+    data()[--size_].~value_type();
+  }
+  void swap(stack &other) noexcept(Capacity == 0) {
+    if constexpr (Capacity == 0) {
+      slots_.swap(other.slots_);
+      std::swap(size_, other.size_);
+    } else {
+      stack tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+  }
+
+ private:
+  value_type *data() noexcept { return slots_.get(); }
+  const value_type *data() const noexcept { return slots_.get(); }
+
+  void destroy_all() noexcept {
+    for (size_type i = 0; i != size_; ++i) {
+      data()[i].~value_type();
+    }
+  }
+
+  void release() noexcept {
+    destroy_all();
+    if constexpr (Capacity == 0) slots_.Release();
+    size_ = 0;
+  }
+
+  // Leaves s empty; the growable mode steals its block.
+  void take(stack &s) {
+    if constexpr (Capacity == 0) {
+      slots_.swap(s.slots_);
+      size_ = s.size_;
+      s.size_ = 0;
+    } else {
+      for (size_type i = 0; i != s.size_; ++i) {
+        push(std::move(s.data()[i]));
+      }
+      s.release();
+    }
+  }
+
+  SlotStorage<value_type, Capacity> slots_;
+  size_type size_{0};
+};
+}  // namespace s21
+
+#endif  // S21_STACK_H
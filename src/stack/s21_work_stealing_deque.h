@@ -0,0 +1,154 @@
+#ifndef S21_WORK_STEALING_DEQUE_H
+#define S21_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+
+// Chase-Lev work-stealing deque for a task scheduler. One owner thread
+// pushes and pops at the bottom like a stack, without locks and, unless
+// it races a thief for the last item, without a CAS. Any number of thief
+// threads take from the top, in FIFO order, with one CAS each. The ring
+// doubles when full; the old one is kept until the deque dies, because a
+// thief may still be reading it.
+//
+// A thief reads its item before it knows whether it won the race for it,
+// so items are stored in lock-free atomics: T is meant to be a task
+// pointer or index.
+template <typename T>
+class work_stealing_deque {
+  static_assert(std::is_trivially_copyable_v<T> &&
+                    std::atomic<T>::is_always_lock_free,
+                "store pointers or indices to the tasks");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  // The capacity is rounded up to a power of two, at least 2.
+  explicit work_stealing_deque(size_type capacity = 32) {
+    size_type size = 2;
+    while (size < capacity) size *= 2;
+    buffers_.push_back(std::make_unique<Buffer>(size));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+  work_stealing_deque(const work_stealing_deque &) = delete;
+  work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+  // Snapshots that other threads may already have changed.
+  bool empty() const noexcept { return size_approx() == 0; }
+  size_type size_approx() const noexcept {
+    index_type bottom = bottom_.load(std::memory_order_relaxed);
+    index_type top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+  }
+  size_type capacity() const noexcept {
+    return buffer_.load(std::memory_order_relaxed)->capacity();
+  }
+
+  // Owner only.
+  void push(value_type value) {
+    index_type bottom = bottom_.load(std::memory_order_relaxed);
+    index_type top = top_.load(std::memory_order_acquire);
+    Buffer *buffer = buffer_.load(std::memory_order_relaxed);
+    if (bottom - top >= static_cast<index_type>(buffer->capacity())) {
+      buffer = Grow(buffer, top, bottom);
+    }
+    buffer->Store(bottom, value);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Owner only: takes the item pushed last. False when the deque is empty
+  // or a thief took the last item first.
+  bool try_pop(value_type &out) {
+    index_type bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer *buffer = buffer_.load(std::memory_order_relaxed);
+    // Reserving the bottom slot must be visible before top is read, or a
+    // thief and the owner could both take it.
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    index_type top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    value_type value = buffer->Load(bottom);
+    if (top == bottom) {
+      bool won = top_.compare_exchange_strong(
+          top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      if (!won) return false;
+    }
+    out = value;
+    return true;
+  }
+
+  // Any thread: takes the item pushed first. False when the deque is
+  // empty or another thread won the race for that item.
+  bool try_steal(value_type &out) {
+    index_type top = top_.load(std::memory_order_seq_cst);
+    index_type bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) return false;
+    Buffer *buffer = buffer_.load(std::memory_order_acquire);
+    value_type value = buffer->Load(top);
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    out = value;
+    return true;
+  }
+
+ private:
+  // Signed, as bottom drops below top for a moment when the owner pops
+  // from an empty deque.
+  using index_type = std::ptrdiff_t;
+
+  class Buffer {
+   public:
+    explicit Buffer(size_type capacity)
+        : mask_(capacity - 1), slots_(new std::atomic<T>[capacity]) {}
+    size_type capacity() const noexcept { return mask_ + 1; }
+    T Load(index_type i) const noexcept {
+      return slots_[static_cast<size_type>(i) & mask_].load(
+          std::memory_order_relaxed);
+    }
+    void Store(index_type i, T value) noexcept {
+      slots_[static_cast<size_type>(i) & mask_].store(
+          value, std::memory_order_relaxed);
+    }
+
+   private:
+    size_type mask_;
+    std::unique_ptr<std::atomic<T>[]> slots_;
+  };
+
+  // Copies the live items into a ring twice the size and publishes it.
+  // Thieves still holding the old one read the same items from it.
+  Buffer *Grow(Buffer *old, index_type top, index_type bottom) {
+    buffers_.reserve(buffers_.size() + 1);
+    auto grown = std::make_unique<Buffer>(old->capacity() * 2);
+    for (index_type i = top; i != bottom; ++i) grown->Store(i, old->Load(i));
+    buffers_.push_back(std::move(grown));
+    Buffer *buffer = buffers_.back().get();
+    buffer_.store(buffer, std::memory_order_release);
+    return buffer;
+  }
+
+  // Keeps the two counters, which thieves and the owner both hammer, on
+  // separate cache lines.
+  static constexpr std::size_t kCacheLine = 64;
+
+  alignas(kCacheLine) std::atomic<index_type> top_{0};
+  alignas(kCacheLine) std::atomic<index_type> bottom_{0};
+  alignas(kCacheLine) std::atomic<Buffer *> buffer_{nullptr};
+  std::vector<std::unique_ptr<Buffer>> buffers_;  // owner only
+};
+
+}  // namespace s21
+
+#endif  // S21_WORK_STEALING_DEQUE_H
@@ -1,7 +1,23 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <functional>
+#include <iterator>
 #include <list>
+#include <map>
+#include <memory>
+#include <queue>
 #include <set>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 #include "./s21_containers.h"
 
@@ -387,6 +403,14 @@ TEST(ListTest, Unique_1) {
   EXPECT_TRUE(compare_lists(my_list, std_list));
 }
 
+TEST(ListTest, Unique_2) {
+  s21::list<int> my_list{1, 1, 1, 2, 2, 3, 3, 3, 3, 4, 1, 1};
+  std::list<int> std_list{1, 1, 1, 2, 2, 3, 3, 3, 3, 4, 1, 1};
+  my_list.unique();
+  std_list.unique();
+  EXPECT_TRUE(compare_lists(my_list, std_list));
+}
+
 TEST(ListTest, Splice_1) {
   s21::list<int> my_list1{1, 9999, 20000};
   s21::list<int> my_list2{500, 15000, 30000};
@@ -431,6 +455,32 @@ TEST(ListTest, Splice_4) {
   EXPECT_TRUE(compare_lists(my_list1, std_list1));
 }
 
+TEST(ListTest, SpliceElementAndRange) {
+  s21::list<int> my_list1{1, 2, 3, 4, 5};
+  s21::list<int> my_list2{10, 20, 30};
+  std::list<int> std_list1{1, 2, 3, 4, 5};
+  std::list<int> std_list2{10, 20, 30};
+  auto moved = ++my_list2.begin();
+  my_list1.splice(my_list1.end(), my_list2, moved);
+  std_list1.splice(std_list1.end(), std_list2, ++std_list2.begin());
+  EXPECT_TRUE(compare_lists(my_list1, std_list1));
+  EXPECT_TRUE(compare_lists(my_list2, std_list2));
+  EXPECT_EQ(*moved, 20);
+
+  my_list2.splice(my_list2.begin(), my_list1, ++my_list1.begin(),
+                  --my_list1.end());
+  std_list2.splice(std_list2.begin(), std_list1, ++std_list1.begin(),
+                   --std_list1.end());
+  EXPECT_TRUE(compare_lists(my_list1, std_list1));
+  EXPECT_TRUE(compare_lists(my_list2, std_list2));
+
+  // Move-to-front inside one list, as an LRU cache does on every hit.
+  my_list2.splice(my_list2.begin(), my_list2, --my_list2.end());
+  std_list2.splice(std_list2.begin(), std_list2, --std_list2.end());
+  my_list2.splice(my_list2.begin(), my_list2, my_list2.begin());
+  EXPECT_TRUE(compare_lists(my_list2, std_list2));
+}
+
 TEST(ListTest, Insert_1) {
   s21::list<int> my_list1{1, 9999, 20000};
   my_list1.insert(my_list1.begin(), 5);
@@ -491,6 +541,26 @@ TEST(ListTest, Insert_6) {
   EXPECT_TRUE(compare_lists(my_list1, std_list1));
 }
 
+TEST(ListTest, InsertMany) {
+  s21::list<std::string> my_list{"c", "f"};
+  std::string moved = "e";
+  auto it = my_list.insert_many(++my_list.begin(), "d", std::move(moved));
+  EXPECT_EQ(*it, "d");
+  my_list.insert_many_front("a", "b");
+  my_list.insert_many_back("g");
+  it = my_list.insert_many(my_list.end());
+  EXPECT_TRUE(it == my_list.end());
+  EXPECT_TRUE(compare_lists(
+      my_list, std::list<std::string>{"a", "b", "c", "d", "e", "f", "g"}));
+  EXPECT_EQ(my_list.back(), "g");
+
+  s21::list<int> empty;
+  empty.insert_many_front(1, 2);
+  empty.insert_many_back(3);
+  EXPECT_TRUE(compare_lists(empty, std::list<int>{1, 2, 3}));
+  EXPECT_EQ(empty.size(), 3u);
+}
+
 TEST(ListTest, Erase_1) {
   s21::list<int> my_list1{1, 9999, 20000};
   my_list1.erase(my_list1.begin());
@@ -533,6 +603,448 @@ TEST(ListTest, Erase_5) {
   EXPECT_TRUE(compare_lists(my_list1, std_list1));
 }
 
+// Shared by every rebound CountingAllocator, so the counts cover node and
+// slab allocations whatever type the container rebinds to.
+struct AllocationCounters {
+  static inline long live = 0;
+  static inline long calls = 0;
+};
+
+template <typename T>
+struct CountingAllocator : AllocationCounters {
+  using value_type = T;
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &) {}
+  T *allocate(std::size_t n) {
+    live += static_cast<long>(n * sizeof(T));
+    ++calls;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) {
+    live -= static_cast<long>(n * sizeof(T));
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <typename U>
+  bool operator==(const CountingAllocator<U> &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U> &) const {
+    return false;
+  }
+};
+
+TEST(ListTest, PoolAllocator) {
+  {
+    s21::list<int, CountingAllocator<int>> my_list;
+    long base_calls = CountingAllocator<int>::calls;
+    for (int i = 0; i < 1000; ++i) my_list.push_back(i);
+    long grown_calls = CountingAllocator<int>::calls;
+    EXPECT_LT(grown_calls - base_calls, 20);
+    for (int round = 0; round < 10; ++round) {
+      for (int i = 0; i < 500; ++i) my_list.pop_front();
+      for (int i = 0; i < 500; ++i) my_list.push_back(i);
+    }
+    EXPECT_EQ(CountingAllocator<int>::calls, grown_calls);
+    EXPECT_EQ(my_list.size(), 1000U);
+    my_list.clear();
+    EXPECT_TRUE(my_list.empty());
+    my_list.push_back(7);
+    EXPECT_EQ(my_list.front(), 7);
+  }
+  EXPECT_EQ(CountingAllocator<int>::live, 0);
+}
+
+TEST(ListTest, SpliceAndMergeRelinkNodes) {
+  using Alloc = CountingAllocator<int>;
+  {
+    s21::list<int, Alloc> lru;
+    for (int i = 0; i < 100; ++i) lru.push_back(i);
+    {
+      s21::list<int, Alloc> incoming{7, 8, 9};
+      lru.splice(lru.begin(), incoming, incoming.begin());
+      long calls = Alloc::calls;
+      for (int i = 0; i < 1000; ++i) {
+        lru.splice(lru.begin(), lru, --lru.end());
+        lru.splice(lru.begin(), incoming, incoming.begin(), incoming.end());
+        incoming.splice(incoming.end(), lru, lru.begin(), lru.begin() + 2);
+      }
+      EXPECT_EQ(Alloc::calls, calls);
+      EXPECT_EQ(lru.size(), 101U);
+    }
+    // The spliced 7 outlives the list it was allocated by.
+    long sum = 0;
+    for (auto it = lru.begin(); it != lru.end(); ++it) sum += *it;
+    EXPECT_EQ(sum, 99 * 100 / 2 + 7);
+
+    s21::list<int, Alloc> odd{1, 3, 5, 7}, even{0, 2, 4, 6, 8};
+    auto two = ++even.begin();
+    odd.merge(even);
+    EXPECT_TRUE(even.empty());
+    EXPECT_EQ(odd.size(), 9U);
+    EXPECT_EQ(*two, 2);
+    EXPECT_EQ(*++two, 3);
+    int expected = 0;
+    for (auto it = odd.begin(); it != odd.end(); ++it) {
+      EXPECT_EQ(*it, expected++);
+    }
+    odd.merge(lru, std::greater<int>());
+    EXPECT_EQ(odd.size(), 110U);
+  }
+  EXPECT_EQ(CountingAllocator<int>::live, 0);
+}
+
+// Lists that once traded nodes share slabs, yet each may then be used,
+// grown and destroyed by its own thread (run under make tsan).
+TEST(ListTest, SplicedListsGrowOnSeparateThreads) {
+  for (int round = 0; round < 20; ++round) {
+    auto left = std::make_unique<s21::list<int>>();
+    auto right = std::make_unique<s21::list<int>>();
+    for (int i = 0; i < 100; ++i) left->push_back(i);
+    right->splice(right->begin(), *left, left->begin(), left->begin() + 50);
+    auto work = [](std::unique_ptr<s21::list<int>> list) {
+      for (int i = 0; i < 5000; ++i) list->push_back(i);
+      for (int i = 0; i < 2500; ++i) list->pop_front();
+      EXPECT_EQ(list->size(), 2550U);
+    };
+    std::thread first(work, std::move(left));
+    std::thread second(work, std::move(right));
+    first.join();
+    second.join();
+  }
+}
+
+TEST(ListTest, MoveAndEmplace) {
+  s21::list<std::string> my_list;
+  std::string word(40, 'x');
+  my_list.push_back(std::move(word));
+  EXPECT_TRUE(word.empty());
+  my_list.emplace_front(3, 'a');
+  my_list.emplace(++my_list.begin(), "mid");
+  EXPECT_EQ(my_list.emplace_back("last"), "last");
+  std::list<std::string> std_list{"aaa", "mid", std::string(40, 'x'),
+                                  "last"};
+  EXPECT_TRUE(compare_lists(my_list, std_list));
+
+  s21::list<std::string> moved;
+  moved = std::move(my_list);
+  EXPECT_EQ(moved.size(), 4U);
+  EXPECT_TRUE(my_list.empty());
+  my_list.push_back("again");
+  EXPECT_EQ(my_list.front(), "again");
+
+  s21::list<std::unique_ptr<int>> owners;
+  owners.push_back(std::make_unique<int>(1));
+  owners.emplace_front(new int(0));
+  owners.insert(owners.end(), std::make_unique<int>(2));
+  int expected = 0;
+  for (auto it = owners.begin(); it != owners.end(); ++it) {
+    EXPECT_EQ(**it, expected++);
+  }
+}
+
+TEST(ListTest, Sort) {
+  s21::list<int> my_list{5, 3, 9, 1, 3, 7, 0};
+  std::list<int> std_list{5, 3, 9, 1, 3, 7, 0};
+  my_list.sort();
+  std_list.sort();
+  EXPECT_TRUE(compare_lists(my_list, std_list));
+  my_list.sort(std::greater<int>());
+  std_list.sort(std::greater<int>());
+  EXPECT_TRUE(compare_lists(my_list, std_list));
+  EXPECT_EQ(*--my_list.end(), 0);
+}
+
+TEST(ListTest, SortLargeSortedAndReverse) {
+  s21::list<int> ascending, descending;
+  for (int i = 0; i < 100000; ++i) {
+    ascending.push_back(i);
+    descending.push_front(i);
+  }
+  ascending.sort();
+  descending.sort();
+  int expected = 0;
+  auto it = descending.begin();
+  for (int value : {0, 1, 2}) {
+    EXPECT_EQ(*it, value);
+    ++it;
+  }
+  for (auto a = ascending.begin(); a != ascending.end(); ++a) {
+    EXPECT_EQ(*a, expected++);
+  }
+  EXPECT_EQ(descending.size(), 100000U);
+  EXPECT_EQ(descending.back(), 99999);
+}
+
+TEST(ListTest, SortIsStableAndKeepsNodes) {
+  using Item = std::pair<int, int>;
+  s21::list<Item> my_list;
+  std::list<Item> std_list;
+  for (int i = 0; i < 1000; ++i) {
+    my_list.push_back({(i * 7919) % 10, i});
+    std_list.push_back({(i * 7919) % 10, i});
+  }
+  auto by_first = [](const Item &a, const Item &b) {
+    return a.first < b.first;
+  };
+  const Item *first_node = &*my_list.begin();
+  my_list.sort(by_first);
+  std_list.sort(by_first);
+  EXPECT_TRUE(compare_lists(my_list, std_list));
+  bool found = false;
+  for (auto it = my_list.begin(); it != my_list.end(); ++it) {
+    found = found || &*it == first_node;
+  }
+  EXPECT_TRUE(found);
+
+  s21::list<std::unique_ptr<int>> owners;
+  for (int i : {3, 1, 2}) owners.push_back(std::make_unique<int>(i));
+  owners.sort([](const auto &a, const auto &b) { return *a < *b; });
+  EXPECT_EQ(**owners.begin(), 1);
+  EXPECT_EQ(**--owners.end(), 3);
+}
+
+template <typename value_type>
+bool compare_unrolled(const s21::unrolled_list<value_type> &my_list,
+                      const std::list<value_type> &std_list) {
+  return my_list.size() == std_list.size() &&
+         std::equal(my_list.begin(), my_list.end(), std_list.begin());
+}
+
+// Inserts and erases at scattered positions split, drain and merge chunks.
+TEST(UnrolledListTest, MatchesStdList) {
+  s21::unrolled_list<int> my_list;
+  std::list<int> std_list;
+  for (int i = 0; i < 3000; ++i) {
+    std::size_t at =
+        (static_cast<std::size_t>(i) * 7919) % (std_list.size() + 1);
+    auto my_it = std::next(my_list.begin(), at);
+    auto std_it = std::next(std_list.begin(), at);
+    if (i % 3 == 2 && at != std_list.size()) {
+      auto my_next = my_list.erase(my_it);
+      auto std_next = std_list.erase(std_it);
+      EXPECT_EQ(my_next == my_list.end(), std_next == std_list.end());
+      if (std_next != std_list.end()) {
+        EXPECT_EQ(*my_next, *std_next);
+      }
+    } else {
+      EXPECT_EQ(*my_list.insert(my_it, i), i);
+      std_list.insert(std_it, i);
+    }
+  }
+  EXPECT_TRUE(compare_unrolled(my_list, std_list));
+  EXPECT_EQ(std::distance(my_list.begin(), my_list.end()),
+            static_cast<std::ptrdiff_t>(std_list.size()));
+  auto my_back = my_list.end();
+  for (auto it = std_list.rbegin(); it != std_list.rend(); ++it) {
+    EXPECT_EQ(*--my_back, *it);
+  }
+  while (std_list.size() > 10) {
+    my_list.pop_front();
+    std_list.pop_front();
+    my_list.pop_back();
+    std_list.pop_back();
+  }
+  EXPECT_TRUE(compare_unrolled(my_list, std_list));
+  my_list.clear();
+  EXPECT_TRUE(my_list.empty());
+  EXPECT_THROW(my_list.pop_back(), std::out_of_range);
+  EXPECT_THROW(my_list.erase(my_list.end()), std::invalid_argument);
+}
+
+TEST(UnrolledListTest, SortUniqueMergeReverse) {
+  s21::unrolled_list<int> my_list;
+  std::list<int> std_list;
+  for (int i = 0; i < 1000; ++i) {
+    my_list.push_front((i * 7919) % 300);
+    std_list.push_front((i * 7919) % 300);
+  }
+  my_list.sort();
+  std_list.sort();
+  EXPECT_TRUE(compare_unrolled(my_list, std_list));
+  my_list.unique();
+  std_list.unique();
+  EXPECT_TRUE(compare_unrolled(my_list, std_list));
+
+  s21::unrolled_list<int> odd;
+  std::list<int> std_odd;
+  for (int i = 1; i < 700; i += 2) {
+    odd.push_back(i);
+    std_odd.push_back(i);
+  }
+  my_list.merge(odd);
+  std_list.merge(std_odd);
+  EXPECT_TRUE(odd.empty());
+  EXPECT_TRUE(compare_unrolled(my_list, std_list));
+  my_list.reverse();
+  std_list.reverse();
+  EXPECT_TRUE(compare_unrolled(my_list, std_list));
+  my_list.sort(std::less<int>());
+  std_list.sort();
+  EXPECT_TRUE(compare_unrolled(my_list, std_list));
+  EXPECT_EQ(my_list.front(), 0);
+  EXPECT_EQ(my_list.back(), 699);
+}
+
+TEST(UnrolledListTest, ThrowingMergeLosesNothing) {
+  s21::unrolled_list<std::string> my_list;
+  s21::unrolled_list<std::string> other;
+  for (int i = 0; i < 200; ++i) {
+    my_list.push_back(std::string(20, 'a' + i % 26));
+    other.push_back(std::string(20, 'a' + (i + 13) % 26));
+  }
+  int calls = 0;
+  auto less = [&calls](const std::string &a, const std::string &b) {
+    if (++calls == 150) throw std::runtime_error("less");
+    return a < b;
+  };
+  EXPECT_THROW(my_list.merge(other, less), std::runtime_error);
+  EXPECT_TRUE(other.empty());
+  ASSERT_EQ(my_list.size(), 400U);
+  std::size_t visited = 0;
+  for (const std::string &word : my_list) {
+    EXPECT_EQ(word.size(), 20U);
+    ++visited;
+  }
+  EXPECT_EQ(visited, 400U);
+}
+
+TEST(UnrolledListTest, StringsMovesAndAliasing) {
+  s21::unrolled_list<std::string> words{"b", "c"};
+  words.push_front(std::string(40, 'a'));
+  for (int i = 0; i < 100; ++i) words.push_back(words.front());
+  words.emplace(std::next(words.begin()), 3, 'z');
+  EXPECT_EQ(words.size(), 104U);
+  EXPECT_EQ(*std::next(words.begin()), "zzz");
+  EXPECT_EQ(words.back(), std::string(40, 'a'));
+
+  s21::unrolled_list<std::string> copy(words);
+  s21::unrolled_list<std::string> moved(std::move(words));
+  EXPECT_TRUE(words.empty());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), moved.begin()));
+  words = std::move(copy);
+  EXPECT_EQ(words.size(), 104U);
+  words.unique();
+  EXPECT_EQ(words.size(), 5U);
+  words.push_back("after");
+  EXPECT_EQ(words.back(), "after");
+
+  s21::unrolled_list<std::unique_ptr<int>> owners;
+  for (int i : {3, 1, 2}) owners.push_back(std::make_unique<int>(i));
+  owners.sort([](const auto &a, const auto &b) { return *a < *b; });
+  EXPECT_EQ(*owners.front(), 1);
+  EXPECT_EQ(*owners.back(), 3);
+}
+
+// A const list hands out const references; its iterators compare with
+// and convert from the mutable ones.
+TEST(UnrolledListTest, ConstIteration) {
+  s21::unrolled_list<int> list{1, 2, 3, 4};
+  const s21::unrolled_list<int> &clist = list;
+  static_assert(std::is_same_v<decltype(*clist.begin()), const int &>);
+  static_assert(std::is_same_v<decltype(*list.begin()), int &>);
+  static_assert(!std::is_convertible_v<s21::unrolled_list<int>::const_iterator,
+                                       s21::unrolled_list<int>::iterator>);
+  int sum = 0;
+  for (const int &value : clist) sum += value;
+  EXPECT_EQ(sum, 10);
+  s21::unrolled_list<int>::const_iterator pos = std::next(list.begin());
+  EXPECT_EQ(pos, std::next(clist.begin()));
+  EXPECT_TRUE(list.begin() != clist.end());
+  list.insert(pos, 7);
+  EXPECT_EQ(*list.erase(clist.begin()), 7);
+  EXPECT_EQ(clist.front(), 7);
+}
+
+struct Mru;
+
+// In two lists at once: every job is queued, and the MRU list holds the
+// recently touched ones.
+struct Job : s21::list_hook<>, s21::list_hook<Mru> {
+  explicit Job(int id) : id(id) {}
+  int id;
+};
+
+TEST(IntrusiveListTest, LinksObjectsInPlace) {
+  std::vector<Job> pool;
+  for (int i = 0; i < 10; ++i) pool.emplace_back(i);
+  s21::intrusive_list<Job> queue;
+  for (Job &job : pool) queue.push_back(job);
+  EXPECT_EQ(queue.size(), 10U);
+  EXPECT_EQ(&queue.front(), &pool[0]);
+  EXPECT_EQ(&queue.back(), &pool[9]);
+  EXPECT_THROW(queue.push_back(pool[3]), std::invalid_argument);
+
+  auto next = queue.erase(queue.iterator_to(pool[3]));
+  EXPECT_EQ(next->id, 4);
+  EXPECT_FALSE(pool[3].s21::list_hook<>::is_linked());
+  queue.insert(queue.begin(), pool[3]);
+  queue.pop_back();
+  int expected[] = {3, 0, 1, 2, 4, 5, 6, 7, 8};
+  int i = 0;
+  for (Job &job : queue) EXPECT_EQ(job.id, expected[i++]);
+  EXPECT_EQ(i, 9);
+  for (auto it = queue.end(); it != queue.begin();) {
+    EXPECT_EQ((--it)->id, expected[--i]);
+  }
+
+  Job copy(pool[0]);
+  EXPECT_FALSE(copy.s21::list_hook<>::is_linked());
+  s21::intrusive_list<Job> moved(std::move(queue));
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(moved.size(), 9U);
+  moved.clear();
+  EXPECT_FALSE(pool[0].s21::list_hook<>::is_linked());
+  EXPECT_THROW(moved.pop_front(), std::out_of_range);
+}
+
+TEST(IntrusiveListTest, TwoListsAndSplice) {
+  std::vector<Job> pool;
+  for (int i = 0; i < 5; ++i) pool.emplace_back(i);
+  s21::intrusive_list<Job> queue;
+  s21::intrusive_list<Job, Mru> mru;
+  for (Job &job : pool) {
+    queue.push_back(job);
+    mru.push_front(job);
+  }
+  // Touching a job moves it to the front of the MRU list only.
+  for (int id : {2, 0, 2}) {
+    mru.splice(mru.begin(), mru, mru.iterator_to(pool[id]));
+  }
+  int expected[] = {2, 0, 4, 3, 1};
+  int i = 0;
+  for (Job &job : mru) EXPECT_EQ(job.id, expected[i++]);
+  i = 0;
+  for (Job &job : queue) EXPECT_EQ(job.id, i++);
+
+  s21::intrusive_list<Job> done;
+  done.splice(done.end(), queue, queue.iterator_to(pool[1]));
+  done.splice(done.begin(), queue);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(done.size(), 5U);
+  EXPECT_EQ(done.back().id, 1);
+  EXPECT_EQ(mru.size(), 5U);
+}
+
+TEST(IntrusiveListTest, ConstIteration) {
+  std::vector<Job> pool;
+  for (int i = 0; i < 4; ++i) pool.emplace_back(i);
+  s21::intrusive_list<Job> queue;
+  for (Job &job : pool) queue.push_back(job);
+  const s21::intrusive_list<Job> &cqueue = queue;
+  static_assert(std::is_same_v<decltype(*cqueue.begin()), const Job &>);
+  static_assert(std::is_same_v<decltype(*queue.begin()), Job &>);
+  int i = 0;
+  for (const Job &job : cqueue) EXPECT_EQ(job.id, i++);
+  EXPECT_EQ(i, 4);
+  s21::intrusive_list<Job>::const_iterator pos = cqueue.iterator_to(pool[2]);
+  EXPECT_EQ(pos, queue.iterator_to(pool[2]));
+  EXPECT_EQ(queue.erase(pos)->id, 3);
+  queue.insert(cqueue.begin(), pool[2]);
+  EXPECT_EQ(cqueue.front().id, 2);
+}
+
 // SET
 
 TEST(set, constructor) {
@@ -622,6 +1134,28 @@ TEST(set, minus) {
   ASSERT_EQ(*it, *it2);
 }
 
+TEST(set, end_is_a_sentinel) {
+  s21::set<int> empty;
+  EXPECT_EQ(empty.begin(), empty.end());
+  s21::set<int> test = {52, 54, 45, 48, 53};
+  EXPECT_EQ(*--test.end(), 54);
+  EXPECT_EQ(*std::prev(test.end(), 2), 53);
+  EXPECT_EQ(++std::prev(test.end()), test.end());
+  EXPECT_EQ(test.find(60), test.end());
+  EXPECT_EQ(test.lower_bound(60), test.end());
+  std::vector<int> backwards(std::make_reverse_iterator(test.end()),
+                             std::make_reverse_iterator(test.begin()));
+  EXPECT_EQ(backwards, (std::vector<int>{54, 53, 52, 48, 45}));
+  test.erase(--test.end());
+  test.erase(test.begin());
+  EXPECT_EQ(*test.begin(), 48);
+  EXPECT_EQ(*--test.end(), 53);
+  EXPECT_THROW(test.erase(test.end()), std::invalid_argument);
+  s21::set<int> moved(std::move(test));
+  EXPECT_EQ(*--moved.end(), 53);
+  EXPECT_EQ(test.begin(), test.end());
+}
+
 TEST(set, find) {
   s21::set<int> test = {52, 54, 45, 48, 53};
   s21::set<int>::iterator it;
@@ -743,6 +1277,494 @@ TEST(set, insert_many) {
   }
 }
 
+// merge shares the node pools of both sets, as splice does for lists.
+TEST(set, merged_sets_grow_on_separate_threads) {
+  for (int round = 0; round < 20; ++round) {
+    auto left = std::make_unique<s21::set<int>>();
+    auto right = std::make_unique<s21::set<int>>();
+    for (int i = 0; i < 100; ++i) left->insert(i);
+    for (int i = 50; i < 150; ++i) right->insert(i);
+    left->merge(*right);
+    auto work = [](std::unique_ptr<s21::set<int>> set) {
+      std::size_t size = set->size();
+      for (int i = 1000; i < 6000; ++i) set->insert(i);
+      for (int i = 1000; i < 3500; ++i) set->erase(set->find(i));
+      EXPECT_EQ(set->size(), size + 2500);
+    };
+    std::thread first(work, std::move(left));
+    std::thread second(work, std::move(right));
+    first.join();
+    second.join();
+  }
+}
+
+// An empty comparator is a base of the tree and adds nothing; one with
+// state, like a function pointer, is stored.
+static_assert(sizeof(s21::set<int>) ==
+              sizeof(s21::set<int, std::greater<int>>));
+static_assert(sizeof(s21::set<int>) <
+              sizeof(s21::set<int, bool (*)(int, int)>));
+
+TEST(set, custom_compare) {
+  s21::set<int, std::greater<int>> test = {3, 1, 4, 1, 5, 9, 2, 6};
+  std::set<int, std::greater<int>> set = {3, 1, 4, 1, 5, 9, 2, 6};
+  EXPECT_TRUE(std::equal(test.begin(), test.end(), set.begin(), set.end()));
+  EXPECT_EQ(*test.find(4), 4);
+  EXPECT_TRUE(test.find(7) == test.end());
+  EXPECT_EQ(*test.lower_bound(7), 6);
+  EXPECT_EQ(*test.upper_bound(6), 5);
+  test.insert_many(7, 0);
+  test.erase(test.find(9));
+  EXPECT_EQ(*test.begin(), 7);
+  EXPECT_EQ(*--test.end(), 0);
+
+  auto by_last_digit = [](int a, int b) { return a % 10 < b % 10; };
+  s21::set<int, bool (*)(int, int)> digits(by_last_digit);
+  digits.insert_many(13, 21, 33, 40);
+  EXPECT_EQ(digits.size(), 3u);
+  EXPECT_EQ(*digits.begin(), 40);
+  EXPECT_TRUE(digits.contains(11));
+  s21::set<int, bool (*)(int, int)> copy(digits);
+  EXPECT_EQ(*copy.find(3), 13);
+  s21::set<int, bool (*)(int, int)> u = set_union(digits, copy);
+  EXPECT_EQ(u.size(), 3u);
+}
+
+TEST(set, insert_many_reports_every_argument) {
+  s21::set<std::string> s = {"b", "d"};
+  auto placed = s.insert_many("c", "a", "d", "c", std::string("e"));
+  ASSERT_EQ(placed.size(), 5u);
+  EXPECT_EQ(*placed[0].first, "c");
+  EXPECT_TRUE(placed[0].second);
+  EXPECT_TRUE(placed[1].second);
+  EXPECT_EQ(*placed[2].first, "d");
+  EXPECT_FALSE(placed[2].second);
+  EXPECT_TRUE(placed[3].first == placed[0].first);
+  EXPECT_FALSE(placed[3].second);
+  EXPECT_TRUE(placed[4].second);
+  EXPECT_EQ(s.size(), 5u);
+
+  std::vector<int> keys(1000);
+  for (int i = 0; i < 1000; ++i) keys[i] = (i * 7919) % 1000;
+  s21::set<int> big = {5000};
+  big.insert(keys.begin(), keys.end());
+  big.insert(keys.begin(), keys.begin() + 10);
+  EXPECT_EQ(big.size(), 1001u);
+  int expected = 0;
+  for (int key : big) {
+    EXPECT_EQ(key, expected);
+    expected = expected == 999 ? 5000 : expected + 1;
+  }
+}
+
+struct ThrowingLess {
+  static int countdown;
+  bool operator()(int a, int b) const {
+    if (countdown > 0 && --countdown == 0) throw std::runtime_error("less");
+    return a < b;
+  }
+};
+int ThrowingLess::countdown = 0;
+
+template <typename Set>
+void expect_valid(const Set &s) {
+  std::size_t visited = 0;
+  int previous = -1;
+  for (int key : s) {
+    ASSERT_LT(previous, key);
+    previous = key;
+    ++visited;
+  }
+  EXPECT_EQ(visited, s.size());
+}
+
+TEST(set, throwing_compare_keeps_tree_valid) {
+  using Set = s21::set<int, ThrowingLess>;
+  std::vector<int> keys(1000);
+  for (int i = 0; i < 1000; ++i) keys[i] = 2 * i;
+  std::vector<int> batch;
+  for (int i = 0; i < 8; ++i) batch.push_back(1 + 250 * i);
+  for (int throw_at = 1; throw_at < 200; throw_at += 7) {
+    Set s(keys.begin(), keys.end());
+    Set other(batch.begin(), batch.end());
+    ThrowingLess::countdown = throw_at;
+    try {
+      s.insert(batch.begin(), batch.end());
+    } catch (const std::runtime_error &) {
+    }
+    ThrowingLess::countdown = throw_at;
+    try {
+      s.insert_many(3, 5, 1001);
+    } catch (const std::runtime_error &) {
+    }
+    ThrowingLess::countdown = throw_at;
+    try {
+      s.merge(other);
+    } catch (const std::runtime_error &) {
+    }
+    ThrowingLess::countdown = 0;
+    expect_valid(s);
+    expect_valid(other);
+    for (int key : batch) EXPECT_TRUE(s.contains(key) || other.contains(key));
+  }
+}
+
+TEST(set, sorted_insert_stays_balanced) {
+  s21::set<int> test;
+  std::set<int> set;
+  for (int i = 0; i < 200000; ++i) {
+    test.insert(i);
+    set.insert(i);
+  }
+  ASSERT_EQ(*test.find(199999), 199999);
+  ASSERT_TRUE(test.contains(100000));
+  ASSERT_FALSE(test.contains(200000));
+  auto it2 = test.begin();
+  for (auto it = set.begin(); it != set.end(); ++it, ++it2) {
+    ASSERT_EQ(*it, *it2);
+  }
+}
+
+TEST(set, erase_rebalance) {
+  s21::set<int> test;
+  std::set<int> set;
+  for (int i = 0; i < 1000; ++i) {
+    int key = (i * 7919) % 1000;
+    test.insert(key);
+    set.insert(key);
+  }
+  for (int i = 0; i < 1000; i += 3) {
+    test.erase(test.find(i));
+    set.erase(i);
+  }
+  ASSERT_EQ(test.size(), set.size());
+  auto it2 = test.begin();
+  for (auto it = set.begin(); it != set.end(); ++it, ++it2) {
+    ASSERT_EQ(*it, *it2);
+  }
+}
+
+TEST(set, size_tracking) {
+  s21::set<int> test = {52, 54, 45, 48, 53};
+  s21::set<int> test2 = {7, 4, 8, 48, 53};
+  test.insert(45);
+  ASSERT_EQ(test.size(), 5U);
+  test.erase(test.begin());
+  ASSERT_EQ(test.size(), 4U);
+  test.swap(test2);
+  ASSERT_EQ(test.size(), 5U);
+  ASSERT_EQ(test2.size(), 4U);
+  test.merge(test2);
+  ASSERT_EQ(test.size(), 7U);
+  s21::set<int> copy(test);
+  ASSERT_EQ(copy.size(), 7U);
+  test.clear();
+  ASSERT_EQ(test.size(), 0U);
+  ASSERT_TRUE(test.empty());
+}
+
+TEST(set, bounds) {
+  s21::set<int> test = {52, 54, 45, 48, 53};
+  std::set<int> set = {52, 54, 45, 48, 53};
+  for (int key = 40; key < 60; ++key) {
+    auto it = test.lower_bound(key);
+    auto it2 = set.lower_bound(key);
+    if (it2 == set.end()) {
+      ASSERT_EQ(it, test.end());
+    } else {
+      ASSERT_EQ(*it, *it2);
+    }
+    it = test.upper_bound(key);
+    it2 = set.upper_bound(key);
+    if (it2 == set.end()) {
+      ASSERT_EQ(it, test.end());
+    } else {
+      ASSERT_EQ(*it, *it2);
+    }
+    ASSERT_EQ(test.count(key), set.count(key));
+  }
+  s21::set<int> empty;
+  ASSERT_EQ(empty.lower_bound(1), empty.end());
+  ASSERT_EQ(empty.equal_range(1).first, empty.equal_range(1).second);
+}
+
+using CountingSet = s21::set<int, std::less<int>, CountingAllocator<int>>;
+
+TEST(set, pool_allocator) {
+  {
+    CountingSet test;
+    for (int i = 0; i < 1000; ++i) test.insert(i);
+    long calls = CountingAllocator<int>::calls;
+    for (int i = 0; i < 1000; i += 2) test.erase(test.find(i));
+    for (int i = 0; i < 1000; i += 2) test.insert(i);
+    EXPECT_EQ(CountingAllocator<int>::calls, calls);
+    CountingSet copy(test);
+    EXPECT_EQ(copy.size(), 1000U);
+    test.clear();
+    EXPECT_TRUE(test.empty());
+  }
+  EXPECT_EQ(CountingAllocator<int>::live, 0);
+}
+
+TEST(set, copy_preallocates_and_is_iterative) {
+  {
+    CountingSet empty;
+    CountingSet empty_copy(empty);
+    EXPECT_TRUE(empty_copy.empty());
+
+    std::vector<int> keys;
+    for (int i = 0; i < 1000000; ++i) keys.push_back(i);
+    CountingSet big(keys.begin(), keys.end());
+    long calls = CountingAllocator<int>::calls;
+    CountingSet copy(big);
+    EXPECT_EQ(CountingAllocator<int>::calls - calls, 1);
+    EXPECT_EQ(copy.size(), big.size());
+    big.erase(big.find(0));
+    EXPECT_EQ(*copy.begin(), 0);
+    EXPECT_EQ(*big.begin(), 1);
+  }
+  EXPECT_EQ(CountingAllocator<int>::live, 0);
+}
+
+struct ThrowingCopy {
+  static inline int copies_left = -1;
+  int key;
+  ThrowingCopy(int k) : key(k) {}
+  ThrowingCopy(const ThrowingCopy &other) : key(other.key) {
+    if (copies_left == 0) throw std::runtime_error("copy failed");
+    --copies_left;
+  }
+  bool operator<(const ThrowingCopy &other) const { return key < other.key; }
+  bool operator==(const ThrowingCopy &other) const {
+    return key == other.key;
+  }
+  bool operator!=(const ThrowingCopy &other) const {
+    return key != other.key;
+  }
+};
+
+TEST(set, copy_cleans_up_after_throw) {
+  {
+    using Set = s21::set<ThrowingCopy, std::less<ThrowingCopy>,
+                         CountingAllocator<ThrowingCopy>>;
+    Set source;
+    for (int i = 0; i < 100; ++i) source.emplace(i);
+    ThrowingCopy::copies_left = 50;
+    EXPECT_THROW(Set copy(source), std::runtime_error);
+    ThrowingCopy::copies_left = -1;
+    Set copy(source);
+    EXPECT_EQ(copy.size(), 100U);
+  }
+  EXPECT_EQ(CountingAllocator<ThrowingCopy>::live, 0);
+}
+
+TEST(set, emplace) {
+  s21::set<std::string> my_set;
+  std::string key(40, 'k');
+  my_set.insert(std::move(key));
+  EXPECT_TRUE(key.empty());
+  auto result = my_set.emplace(3, 'b');
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(*result.first, "bbb");
+  result = my_set.emplace("bbb");
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(my_set.size(), 2U);
+
+  s21::set<int> numbers;
+  auto hint = numbers.end();
+  for (int i = 0; i < 100; ++i) hint = numbers.emplace_hint(numbers.end(), i);
+  EXPECT_EQ(*hint, 99);
+  // A wrong hint still lands the key in order, a duplicate is rejected.
+  EXPECT_EQ(*numbers.emplace_hint(numbers.begin(), 200), 200);
+  EXPECT_EQ(*numbers.emplace_hint(numbers.end(), 50), 50);
+  EXPECT_EQ(numbers.size(), 101U);
+  int expected = 0;
+  for (auto it = numbers.begin(); *it != 200; ++it) {
+    EXPECT_EQ(*it, expected++);
+  }
+}
+
+TEST(set, range_constructor) {
+  std::vector<int> sorted;
+  for (int i = 0; i < 100000; ++i) sorted.push_back(i / 2);
+  s21::set<int> my_set(sorted.begin(), sorted.end());
+  EXPECT_EQ(my_set.size(), 50000U);
+  int expected = 0;
+  for (auto it = my_set.begin(); it != my_set.end(); ++it) {
+    EXPECT_EQ(*it, expected++);
+  }
+
+  std::vector<int> shuffled{5, 1, 4, 1, 3, 9, 2, 6, 5};
+  s21::set<int> small(shuffled.begin(), shuffled.end());
+  std::set<int> std_set(shuffled.begin(), shuffled.end());
+  EXPECT_EQ(small.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto it = small.begin(); it != small.end(); ++it) {
+    EXPECT_EQ(*it, *std_it++);
+  }
+  // The bulk-built tree keeps working as a normal one.
+  for (int i = 0; i < 50000; i += 3) my_set.erase(my_set.find(i));
+  my_set.insert(-1);
+  EXPECT_EQ(*my_set.begin(), -1);
+  EXPECT_EQ(my_set.size(), 50000U - 16667U + 1U);
+}
+
+TEST(set, merge_moves_nodes) {
+  s21::set<std::string> my_set{"a", "c"};
+  const std::string *c = &*my_set.find("c");
+  {
+    s21::set<std::string> other{"b", "c", "d"};
+    const std::string *b = &*other.find("b");
+    my_set.merge(other);
+    EXPECT_EQ(&*my_set.find("b"), b);
+    // "c" was already there, so other keeps its own.
+    EXPECT_EQ(other.size(), 1U);
+    EXPECT_EQ(*other.begin(), "c");
+    EXPECT_NE(&*other.begin(), c);
+  }
+  EXPECT_EQ(my_set.size(), 4U);
+  EXPECT_EQ(*my_set.find("d"), "d");
+  my_set.insert("e");
+  EXPECT_EQ(my_set.size(), 5U);
+}
+
+TEST(set, set_algebra) {
+  s21::set<int> a{1, 2, 3, 5, 8, 13};
+  s21::set<int> b{2, 4, 8, 16};
+  std::vector<int> expected;
+  auto check = [&](const s21::set<int> &result) {
+    ASSERT_EQ(result.size(), expected.size());
+    auto it = result.begin();
+    for (int key : expected) EXPECT_EQ(*it++, key);
+  };
+  expected = {1, 2, 3, 4, 5, 8, 13, 16};
+  check(set_union(a, b));
+  expected = {2, 8};
+  check(set_intersection(a, b));
+  expected = {1, 3, 5, 13};
+  check(set_difference(a, b));
+  expected = {};
+  check(set_intersection(a, s21::set<int>()));
+}
+
+TEST(set, parallel_set_algebra) {
+  std::vector<int> even, thirds;
+  for (int i = 0; i < 200000; i += 2) even.push_back(i);
+  for (int i = 0; i < 200000; i += 3) thirds.push_back(i);
+  s21::set<int> a(even.begin(), even.end()), b(thirds.begin(), thirds.end());
+  std::vector<int> expected;
+  std::set_union(even.begin(), even.end(), thirds.begin(), thirds.end(),
+                 std::back_inserter(expected));
+  s21::set<int> result = set_union(a, b, 4);
+  ASSERT_EQ(result.size(), expected.size());
+  auto it = result.begin();
+  for (int key : expected) EXPECT_EQ(*it++, key);
+  expected.clear();
+  std::set_difference(even.begin(), even.end(), thirds.begin(), thirds.end(),
+                      std::back_inserter(expected));
+  result = set_difference(a, b, 0);
+  ASSERT_EQ(result.size(), expected.size());
+  it = result.begin();
+  for (int key : expected) EXPECT_EQ(*it++, key);
+  EXPECT_EQ(set_intersection(a, b, 3).size(), 200000U / 6 + 1);
+}
+
+struct Page : s21::list_hook<>, s21::set_hook<> {
+  explicit Page(int id) : id(id) {}
+  int id;
+};
+
+struct PageById {
+  bool operator()(const Page &a, const Page &b) const { return a.id < b.id; }
+  bool operator()(const Page &a, int id) const { return a.id < id; }
+  bool operator()(int id, const Page &b) const { return id < b.id; }
+};
+
+TEST(IntrusiveSetTest, MatchesStdSet) {
+  std::vector<Page> pool;
+  for (int i = 0; i < 2000; ++i) pool.emplace_back((i * 7919) % 1000);
+  s21::intrusive_set<Page, PageById> index;
+  std::set<int> ids;
+  for (std::size_t i = 0; i < pool.size(); ++i) {
+    bool fresh = ids.insert(pool[i].id).second;
+    auto result = index.insert(pool[i]);
+    EXPECT_EQ(result.second, fresh);
+    EXPECT_EQ(result.first->id, pool[i].id);
+    if (i % 3 == 0) {
+      int id = pool[(i * 31) % (i + 1)].id;
+      EXPECT_EQ(index.erase(id), ids.erase(id));
+    }
+  }
+  ASSERT_EQ(index.size(), ids.size());
+  EXPECT_TRUE(std::equal(
+      ids.begin(), ids.end(), index.begin(),
+      [](int id, const Page &page) { return page.id == id; }));
+  EXPECT_EQ(index.find(-1), index.end());
+  EXPECT_EQ(index.lower_bound(500)->id, *ids.lower_bound(500));
+  EXPECT_EQ(index.upper_bound(500)->id, *ids.upper_bound(500));
+  EXPECT_EQ((--index.end())->id, *ids.rbegin());
+  for (auto it = index.begin(); it != index.end();) it = index.erase(it);
+  EXPECT_TRUE(index.empty());
+  for (const Page &page : pool) {
+    EXPECT_FALSE(page.s21::set_hook<>::is_linked());
+  }
+}
+
+// One page sits in an LRU list and an index by id; evicting it from both
+// allocates nothing and copies nothing.
+TEST(IntrusiveSetTest, ListAndSetMembership) {
+  std::vector<Page> pool;
+  for (int i = 0; i < 8; ++i) pool.emplace_back(100 - i);
+  s21::intrusive_list<Page> lru;
+  s21::intrusive_set<Page, PageById> index;
+  for (Page &page : pool) {
+    lru.push_front(page);
+    EXPECT_TRUE(index.insert(page).second);
+  }
+  Page &hit = *index.find(97);
+  lru.splice(lru.begin(), lru, lru.iterator_to(hit));
+  Page &victim = lru.back();
+  lru.pop_back();
+  index.erase(index.iterator_to(victim));
+  EXPECT_EQ(victim.id, 100);
+  EXPECT_FALSE(index.contains(100));
+  EXPECT_EQ(index.count(97), 1U);
+  EXPECT_EQ(lru.front().id, 97);
+  EXPECT_EQ(index.begin()->id, 93);
+  EXPECT_THROW(index.insert(hit), std::invalid_argument);
+
+  s21::intrusive_set<Page, PageById> moved(std::move(index));
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(moved.size(), 7U);
+  index = std::move(moved);
+  EXPECT_EQ(index.size(), 7U);
+  index.clear();
+  EXPECT_TRUE(index.insert(victim).second);
+  EXPECT_EQ(lru.size(), 7U);
+}
+
+TEST(IntrusiveSetTest, ConstLookup) {
+  std::vector<Page> pool;
+  for (int i = 0; i < 6; ++i) pool.emplace_back(i * 10);
+  s21::intrusive_set<Page, PageById> index;
+  for (Page &page : pool) index.insert(page);
+  const s21::intrusive_set<Page, PageById> &cindex = index;
+  static_assert(std::is_same_v<decltype(*cindex.find(10)), const Page &>);
+  static_assert(std::is_same_v<decltype(*index.find(10)), Page &>);
+  int id = 0;
+  for (const Page &page : cindex) {
+    EXPECT_EQ(page.id, id);
+    id += 10;
+  }
+  s21::intrusive_set<Page, PageById>::const_iterator pos =
+      cindex.lower_bound(15);
+  EXPECT_EQ(pos, index.iterator_to(pool[2]));
+  EXPECT_EQ(cindex.upper_bound(20), cindex.iterator_to(pool[3]));
+  EXPECT_EQ(index.erase(pos)->id, 30);
+  EXPECT_FALSE(cindex.contains(20));
+  EXPECT_EQ(cindex.find(20), cindex.end());
+}
+
 // MULTISET
 
 TEST(MultisetTest, DefaultConstructor) {
@@ -823,6 +1845,36 @@ TEST(multiset, range) {
   EXPECT_EQ(*check.second, *check2.second);
 }
 
+TEST(MultisetTest, Duplicates) {
+  s21::multiset<int> mySet;
+  std::multiset<int> stdSet;
+  for (int i = 0; i < 500; ++i) {
+    mySet.insert(i % 7);
+    stdSet.insert(i % 7);
+  }
+  mySet.erase(mySet.begin());
+  stdSet.erase(stdSet.begin());
+  auto it2 = mySet.begin();
+  for (auto it = stdSet.begin(); it != stdSet.end(); ++it, ++it2) {
+    ASSERT_EQ(*it, *it2);
+  }
+  ASSERT_EQ(it2, mySet.end());
+}
+
+TEST(MultisetTest, IteratesBackwardOverDuplicates) {
+  s21::multiset<int> mySet;
+  std::multiset<int> stdSet;
+  for (int i = 0; i < 300; ++i) {
+    mySet.insert(i * 7 % 11);
+    stdSet.insert(i * 7 % 11);
+  }
+  auto it = mySet.end();
+  for (auto rit = stdSet.rbegin(); rit != stdSet.rend(); ++rit) {
+    ASSERT_EQ(*--it, *rit);
+  }
+  ASSERT_EQ(it, mySet.begin());
+}
+
 TEST(MultisetTest, Insert) {
   s21::multiset<int> mySet;
   auto result1 = mySet.insert(42);
@@ -830,6 +1882,139 @@ TEST(MultisetTest, Insert) {
   ASSERT_EQ(result1.first, mySet.begin());
 }
 
+TEST(MultisetTest, InsertReturnsNewNode) {
+  s21::multiset<int> mySet = {5, 5, 5};
+  auto result = mySet.insert(5);
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(*result.first, 5);
+  ++result.first;
+  ASSERT_EQ(result.first, mySet.end());
+  auto tail = mySet.insert(7).first;
+  ASSERT_EQ(++tail, mySet.end());
+}
+
+TEST(MultisetTest, CountEqualRange) {
+  s21::multiset<int> mySet = {3, 1, 2, 3, 2, 3, 5};
+  ASSERT_EQ(mySet.count(3), 3U);
+  ASSERT_EQ(mySet.count(2), 2U);
+  ASSERT_EQ(mySet.count(4), 0U);
+  auto range = mySet.equal_range(3);
+  int n = 0;
+  for (auto it = range.first; it != range.second; ++it, ++n) {
+    ASSERT_EQ(*it, 3);
+  }
+  ASSERT_EQ(n, 3);
+  ASSERT_EQ(*range.second, 5);
+  ASSERT_EQ(mySet.upper_bound(5), mySet.end());
+}
+
+TEST(MultisetTest, EmplaceHint) {
+  s21::multiset<int> my_multiset{1, 3, 3, 5};
+  auto it = my_multiset.emplace(3);
+  EXPECT_EQ(*it, 3);
+  it = my_multiset.emplace_hint(my_multiset.begin(), 3);
+  it = my_multiset.emplace_hint(my_multiset.end(), 0);
+  EXPECT_EQ(it, my_multiset.begin());
+  std::multiset<int> std_multiset{0, 1, 3, 3, 3, 3, 5};
+  EXPECT_EQ(my_multiset.count(3), 4U);
+  auto std_it = std_multiset.begin();
+  for (auto my_it = my_multiset.begin(); my_it != my_multiset.end(); ++my_it) {
+    EXPECT_EQ(*my_it, *std_it++);
+  }
+  EXPECT_EQ(std_it, std_multiset.end());
+}
+
+TEST(MultisetTest, RangeConstructorAndMerge) {
+  std::vector<int> keys{3, 1, 3, 2, 1, 3};
+  s21::multiset<int> my_multiset(keys.begin(), keys.end());
+  s21::multiset<int> other{1, 3, 4};
+  my_multiset.merge(other);
+  std::multiset<int> std_multiset(keys.begin(), keys.end());
+  std_multiset.insert({1, 3, 4});
+  EXPECT_EQ(my_multiset.size(), std_multiset.size());
+  EXPECT_EQ(my_multiset.count(3), 4U);
+  auto std_it = std_multiset.begin();
+  for (auto it = my_multiset.begin(); it != my_multiset.end(); ++it) {
+    EXPECT_EQ(*it, *std_it++);
+  }
+}
+
+TEST(MultisetTest, CustomCompare) {
+  s21::multiset<int, std::greater<int>> ms = {2, 5, 2, 8};
+  ms.insert(5);
+  std::multiset<int, std::greater<int>> std_ms = {2, 5, 2, 8, 5};
+  EXPECT_TRUE(std::equal(ms.begin(), ms.end(), std_ms.begin(),
+                         std_ms.end()));
+  EXPECT_EQ(ms.count(5), 2u);
+  EXPECT_EQ(*ms.upper_bound(5), 2);
+}
+
+TEST(MultisetTest, InsertManyKeepsEquals) {
+  s21::multiset<int> ms = {2, 4};
+  auto placed = ms.insert_many(4, 1, 2, 4);
+  for (const auto &p : placed) EXPECT_TRUE(p.second);
+  EXPECT_EQ(*placed[1].first, 1);
+  EXPECT_EQ(ms.count(4), 3u);
+  std::vector<int> more = {3, 2, 3};
+  ms.insert(more.begin(), more.end());
+  std::multiset<int> std_ms = {1, 2, 2, 2, 3, 3, 4, 4, 4};
+  EXPECT_TRUE(std::equal(ms.begin(), ms.end(), std_ms.begin(),
+                         std_ms.end()));
+}
+
+struct ByKey {
+  bool operator()(const std::pair<int, int> &a,
+                  const std::pair<int, int> &b) const {
+    return a.first < b.first;
+  }
+};
+
+TEST(MultisetTest, BatchesGoAfterEqualKeys) {
+  using Item = std::pair<int, int>;
+  std::vector<Item> items;
+  for (int j = 0; j < 4; ++j) {
+    for (int k = 0; k < 50; ++k) items.push_back({k, k + 50 * j});
+  }
+  s21::multiset<Item, ByKey> ms(items.begin(), items.end());
+  std::multiset<Item, ByKey> std_ms(items.begin(), items.end());
+  auto same = [&] {
+    return std::equal(ms.begin(), ms.end(), std_ms.begin(), std_ms.end());
+  };
+  ms.insert_many(Item{6, 1000}, Item{7, 1001});
+  std_ms.insert({{6, 1000}, {7, 1001}});
+  EXPECT_TRUE(same());
+  s21::multiset<Item, ByKey> other = {{6, 2000}, {7, 2001}};
+  std::multiset<Item, ByKey> std_other = {{6, 2000}, {7, 2001}};
+  ms.merge(other);
+  std_ms.merge(std_other);
+  EXPECT_TRUE(same());
+  // As large as the tree, so it is merged and rebuilt.
+  for (Item &item : items) item.second += 3000;
+  ms.insert(items.begin(), items.end());
+  std_ms.insert(items.begin(), items.end());
+  EXPECT_TRUE(same());
+}
+
+TEST(MultisetTest, SetAlgebraCounts) {
+  std::vector<int> x{1, 1, 1, 2, 3, 3}, y{1, 3, 3, 3, 4};
+  s21::multiset<int> a(x.begin(), x.end()), b(y.begin(), y.end());
+  std::vector<int> expected;
+  std::set_intersection(x.begin(), x.end(), y.begin(), y.end(),
+                        std::back_inserter(expected));
+  s21::multiset<int> result = set_intersection(a, b);
+  ASSERT_EQ(result.size(), expected.size());
+  auto it = result.begin();
+  for (int key : expected) EXPECT_EQ(*it++, key);
+  expected.clear();
+  std::set_union(x.begin(), x.end(), y.begin(), y.end(),
+                 std::back_inserter(expected));
+  result = set_union(a, b);
+  ASSERT_EQ(result.size(), expected.size());
+  it = result.begin();
+  for (int key : expected) EXPECT_EQ(*it++, key);
+  EXPECT_EQ(set_difference(a, b).count(1), 2U);
+}
+
 TEST(MultisetTest, Clear) {
   s21::multiset<int> mySet = {1, 2, 3};
   ASSERT_FALSE(mySet.empty());
@@ -839,6 +2024,1101 @@ TEST(MultisetTest, Clear) {
   ASSERT_EQ(mySet.size(), 0);
 }
 
+// MAP
+
+TEST(MapTest, InitAndOrder) {
+  s21::map<int, std::string> my_map = {{3, "c"}, {1, "a"}, {2, "b"}};
+  std::map<int, std::string> std_map = {{3, "c"}, {1, "a"}, {2, "b"}};
+  ASSERT_EQ(my_map.size(), std_map.size());
+  auto it = my_map.begin();
+  for (const auto &item : std_map) {
+    EXPECT_EQ(it->first, item.first);
+    EXPECT_EQ((*it).second, item.second);
+    ++it;
+  }
+  EXPECT_EQ(it, my_map.end());
+}
+
+TEST(MapTest, ElementAccess) {
+  s21::map<std::string, int> my_map;
+  my_map["one"] = 1;
+  my_map["two"] += 2;
+  EXPECT_EQ(my_map.at("one"), 1);
+  EXPECT_EQ(my_map["two"], 2);
+  EXPECT_EQ(my_map.size(), 2U);
+  EXPECT_THROW(my_map.at("three"), std::out_of_range);
+}
+
+TEST(MapTest, InsertVariants) {
+  s21::map<int, int> my_map;
+  auto result = my_map.insert({1, 10});
+  EXPECT_TRUE(result.second);
+  result = my_map.insert(1, 20);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first->second, 10);
+  result = my_map.insert_or_assign(1, 30);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(my_map.at(1), 30);
+  result = my_map.insert_or_assign(2, 40);
+  EXPECT_TRUE(result.second);
+  result = my_map.try_emplace(2, 50);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first->second, 40);
+  result = my_map.try_emplace(3, 60);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(my_map.size(), 3U);
+}
+
+TEST(MapTest, InsertOrAssignMoves) {
+  s21::map<std::string, std::unique_ptr<int>> my_map;
+  std::string key(40, 'k');
+  auto result = my_map.insert_or_assign(std::move(key),
+                                        std::make_unique<int>(1));
+  EXPECT_TRUE(result.second);
+  EXPECT_TRUE(key.empty());
+  std::string same(40, 'k');
+  result = my_map.insert_or_assign(std::move(same), std::make_unique<int>(2));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(same, std::string(40, 'k'));
+  EXPECT_EQ(*my_map.at(same), 2);
+  EXPECT_EQ(my_map.size(), 1U);
+}
+
+TEST(MapTest, EmplaceMoves) {
+  s21::map<std::string, std::string> my_map;
+  std::string key(40, 'k'), value(40, 'v');
+  auto result = my_map.try_emplace(std::move(key), std::move(value));
+  EXPECT_TRUE(result.second);
+  EXPECT_TRUE(key.empty());
+  EXPECT_TRUE(value.empty());
+  result = my_map.emplace("a", "first");
+  EXPECT_TRUE(result.second);
+  result = my_map.emplace("a", "second");
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first->second, "first");
+  auto it = my_map.emplace_hint(my_map.end(), "z", "last");
+  EXPECT_EQ(it->second, "last");
+  my_map[std::string("b")] = "b";
+  EXPECT_EQ(my_map.size(), 4U);
+}
+
+TEST(MapTest, RangeConstructorKeepsFirst) {
+  std::vector<std::pair<int, char>> items{{2, 'b'}, {1, 'a'}, {2, 'x'}};
+  s21::map<int, char> my_map(items.begin(), items.end());
+  std::map<int, char> std_map(items.begin(), items.end());
+  EXPECT_EQ(my_map.size(), std_map.size());
+  EXPECT_EQ(my_map.at(2), std_map.at(2));
+  EXPECT_EQ(my_map.begin()->second, 'a');
+}
+
+TEST(MapTest, KeyOnlyComparison) {
+  struct Unordered {
+    int payload;
+  };
+  s21::map<int, Unordered> my_map;
+  my_map.insert(2, Unordered{20});
+  my_map.insert(1, Unordered{10});
+  my_map.insert(2, Unordered{30});
+  EXPECT_EQ(my_map.size(), 2U);
+  EXPECT_EQ(my_map.find(2)->second.payload, 20);
+}
+
+struct Caseless {
+  bool operator()(const std::string &a, const std::string &b) const {
+    return std::lexicographical_compare(
+        a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+          return std::tolower(static_cast<unsigned char>(x)) <
+                 std::tolower(static_cast<unsigned char>(y));
+        });
+  }
+};
+
+TEST(MapTest, CustomCompare) {
+  s21::map<std::string, int, Caseless> my_map = {{"Beta", 2}, {"alpha", 1}};
+  EXPECT_FALSE(my_map.insert({"ALPHA", 10}).second);
+  EXPECT_EQ(my_map.at("BETA"), 2);
+  my_map["Gamma"] = 3;
+  EXPECT_EQ(my_map.begin()->first, "alpha");
+  EXPECT_EQ((--my_map.end())->first, "Gamma");
+  EXPECT_EQ(my_map.count("gamma"), 1u);
+  EXPECT_TRUE(my_map.key_comp()("a", "B"));
+}
+
+TEST(MapTest, HeterogeneousLookup) {
+  s21::map<std::string, int, std::less<>> my_map = {{"alpha", 1},
+                                                   {"beta", 2}};
+  std::string_view key = "beta";
+  EXPECT_TRUE(my_map.contains(key));
+  EXPECT_EQ(my_map.find(key)->second, 2);
+  EXPECT_EQ(my_map.count(std::string_view("gamma")), 0U);
+  EXPECT_EQ(my_map.lower_bound(std::string_view("b"))->first, "beta");
+}
+
+TEST(MapTest, EraseSwapMerge) {
+  s21::map<int, int> a = {{1, 1}, {2, 2}, {3, 3}};
+  s21::map<int, int> b = {{3, 30}, {4, 40}};
+  a.erase(a.find(2));
+  EXPECT_FALSE(a.contains(2));
+  a.merge(b);
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_EQ(a.at(3), 3);
+  EXPECT_EQ(a.at(4), 40);
+  a.swap(b);
+  EXPECT_EQ(b.size(), 3U);
+  s21::map<int, int> copy(b);
+  EXPECT_EQ(copy.at(4), 40);
+}
+
+// BTREE
+
+TEST(BtreeSetTest, MatchesStdSet) {
+  s21::btree_set<int> my_set;
+  std::set<int> std_set;
+  unsigned seed = 1;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>(seed >> 8) % 4000 - 2000;
+    if (i % 3 == 0) {
+      auto it = my_set.find(key);
+      ASSERT_EQ(it == my_set.end(), std_set.count(key) == 0);
+      if (it != my_set.end()) my_set.erase(it);
+      std_set.erase(key);
+    } else {
+      ASSERT_EQ(my_set.insert(key).second, std_set.insert(key).second);
+    }
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  auto it = my_set.begin();
+  for (int key : std_set) ASSERT_EQ(*it++, key);
+  ASSERT_EQ(it, my_set.end());
+  for (auto rit = std_set.rbegin(); rit != std_set.rend(); ++rit) {
+    ASSERT_EQ(*--it, *rit);
+  }
+  ASSERT_EQ(it, my_set.begin());
+  while (!my_set.empty()) my_set.erase(my_set.begin());
+  EXPECT_EQ(my_set.begin(), my_set.end());
+}
+
+TEST(BtreeSetTest, SortedInsertPacksLeaves) {
+  s21::btree_set<int, std::less<int>, CountingAllocator<int>> my_set;
+  long base_live = CountingAllocator<int>::live;
+  for (int i = 0; i < 100000; ++i) my_set.insert(i);
+  long bytes = CountingAllocator<int>::live - base_live;
+  EXPECT_LT(bytes, 100000L * 5);
+  EXPECT_EQ(*--my_set.end(), 99999);
+  EXPECT_EQ(*my_set.lower_bound(-5), 0);
+  EXPECT_EQ(my_set.upper_bound(99999), my_set.end());
+  my_set.clear();
+  EXPECT_EQ(CountingAllocator<int>::live, base_live);
+}
+
+TEST(BtreeSetTest, UnsignedAndStringKeys) {
+  s21::btree_set<unsigned> big = {4000000000u, 1u, 3000000000u, 2147483648u};
+  EXPECT_EQ(*big.begin(), 1u);
+  EXPECT_EQ(*big.lower_bound(2147483649u), 3000000000u);
+  EXPECT_EQ(*big.upper_bound(3000000000u), 4000000000u);
+  s21::btree_set<std::string> words;
+  std::set<std::string> std_words;
+  for (int i = 0; i < 2000; ++i) {
+    std::string word = std::to_string(i * 7919 % 2000);
+    words.insert(word);
+    std_words.insert(word);
+  }
+  auto it = words.begin();
+  for (const auto &word : std_words) ASSERT_EQ(*it++, word);
+  EXPECT_TRUE(words.contains("1999"));
+  EXPECT_FALSE(words.contains("2000"));
+}
+
+TEST(BtreeSetTest, RangeBuildCopyAndMerge) {
+  std::vector<int> keys;
+  for (int i = 0; i < 5000; ++i) keys.push_back(i * 37 % 5000);
+  s21::btree_set<int> a(keys.begin(), keys.end());
+  EXPECT_EQ(a.size(), 5000U);
+  s21::btree_set<int> copy(a);
+  EXPECT_EQ(copy.size(), 5000U);
+  s21::btree_set<int> b = {-1, 10, 4999, 6000};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 5002U);
+  EXPECT_EQ(b.size(), 2U);
+  EXPECT_TRUE(b.contains(10));
+  EXPECT_EQ(*a.begin(), -1);
+  EXPECT_EQ(*--a.end(), 6000);
+  int expected = 0;
+  for (int key : copy) ASSERT_EQ(key, expected++);
+  s21::btree_set<int> moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 5000U);
+  EXPECT_TRUE(copy.empty());
+}
+
+// std::greater keeps the SSE2 search out, so the keys go through Compare.
+TEST(BtreeSetTest, CustomCompare) {
+  s21::btree_set<int, std::greater<int>> my_set;
+  std::set<int, std::greater<int>> std_set;
+  for (int i = 0; i < 5000; ++i) {
+    int key = i * 7919 % 3000 - 1500;
+    ASSERT_EQ(my_set.insert(key).second, std_set.insert(key).second);
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(std_set.begin(), std_set.end(), my_set.begin(),
+                         my_set.end()));
+  EXPECT_EQ(*my_set.begin(), 1499);
+  EXPECT_EQ(*my_set.lower_bound(2000), 1499);
+  EXPECT_EQ(my_set.upper_bound(-1500), my_set.end());
+  EXPECT_TRUE(my_set.key_comp()(2, 1));
+  std::vector<int> keys = {3, 1, 3, 2};
+  s21::btree_multiset<int, std::greater<int>> ms(keys.begin(), keys.end());
+  int expected[] = {3, 3, 2, 1};
+  EXPECT_TRUE(std::equal(std::begin(expected), std::end(expected),
+                         ms.begin(), ms.end()));
+  EXPECT_EQ(ms.count(3), 2U);
+}
+
+// A batch into a small tree is merged in one rebuild; one into a big tree
+// goes in value by value and splits leaves. Either way every position
+// returned must still be valid.
+template <typename... Args>
+void ExpectInsertManyPositions(int existing, Args... args) {
+  s21::btree_set<int> my_set;
+  std::set<int> std_set;
+  for (int i = 0; i < existing; ++i) {
+    my_set.insert(i * 2 + 1000);
+    std_set.insert(i * 2 + 1000);
+  }
+  auto placed = my_set.insert_many(args...);
+  int keys[] = {args...};
+  ASSERT_EQ(placed.size(), sizeof...(args));
+  for (std::size_t i = 0; i < placed.size(); ++i) {
+    EXPECT_EQ(*placed[i].first, keys[i]);
+    EXPECT_EQ(placed[i].second, std_set.insert(keys[i]).second);
+  }
+  EXPECT_EQ(my_set.size(), std_set.size());
+}
+
+TEST(BtreeSetTest, InsertManyKeepsEveryPosition) {
+  for (int existing : {0, 20000}) {
+    ExpectInsertManyPositions(existing, 1100, 5, 1, 3, 2, 7, 4, 9, 8, 6, 13,
+                              11, 5, 12, 10, 15, 14, 17, 16, 19, 18, 21, 20,
+                              23, 22, 25, 24, 27, 26, 29, 28, 31, 30, 33, 32,
+                              35, 34, 37, 36, 39, 38, 41, 40, 43, 42, 45, 44,
+                              47, 46, 49, 48, 51, 50, 53, 52, 55, 54, 57, 56,
+                              59, 58, 61, 60, 63, 62, 1101, 1);
+  }
+}
+
+TEST(BtreeMultisetTest, Duplicates) {
+  s21::btree_multiset<int> my_set;
+  std::multiset<int> std_set;
+  for (int i = 0; i < 3000; ++i) {
+    my_set.insert(i % 13);
+    std_set.insert(i % 13);
+  }
+  EXPECT_EQ(my_set.count(5), std_set.count(5));
+  auto range = my_set.equal_range(7);
+  std::size_t in_range = 0;
+  for (auto it = range.first; it != range.second; ++it) {
+    ASSERT_EQ(*it, 7);
+    ++in_range;
+  }
+  EXPECT_EQ(in_range, std_set.count(7));
+  for (int i = 0; i < 1000; ++i) {
+    my_set.erase(my_set.find(i % 13));
+    std_set.erase(std_set.find(i % 13));
+  }
+  auto it = my_set.begin();
+  for (int key : std_set) ASSERT_EQ(*it++, key);
+  s21::btree_multiset<int> other = {5, 5, 20};
+  my_set.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(my_set.count(5), std_set.count(5) + 2);
+}
+
+TEST(BtreeMapTest, ElementAccessAndLookup) {
+  s21::btree_map<std::string, int> my_map = {{"beta", 2}, {"alpha", 1}};
+  my_map["gamma"] = 3;
+  my_map.insert_or_assign("alpha", 10);
+  EXPECT_EQ(my_map.at("alpha"), 10);
+  EXPECT_FALSE(my_map.insert("beta", 20).second);
+  EXPECT_EQ(my_map.try_emplace("delta", 4).first->second, 4);
+  EXPECT_THROW(my_map.at("omega"), std::out_of_range);
+  EXPECT_EQ(my_map.begin()->first, "alpha");
+  EXPECT_EQ((--my_map.end())->first, "gamma");
+  s21::btree_map<int, int> numbers;
+  std::map<int, int> std_numbers;
+  for (int i = 0; i < 10000; ++i) {
+    numbers[i * 7 % 1000] += i;
+    std_numbers[i * 7 % 1000] += i;
+  }
+  auto it = numbers.begin();
+  for (const auto &item : std_numbers) {
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ(it->second, item.second);
+    ++it;
+  }
+}
+
+TEST(BtreeMultisetTest, InsertManyKeepsEveryPosition) {
+  for (int existing : {0, 20000}) {
+    s21::btree_multiset<int> my_set;
+    for (int i = 0; i < existing; ++i) my_set.insert(i % 50);
+    auto placed = my_set.insert_many(7, 3, 7, 100, 3, 7);
+    ASSERT_EQ(placed.size(), 6U);
+    for (const auto &item : placed) EXPECT_TRUE(item.second);
+    int expected[] = {7, 3, 7, 100, 3, 7};
+    for (int i = 0; i < 6; ++i) EXPECT_EQ(*placed[i].first, expected[i]);
+    // Equal arguments keep their order, after the equals already there.
+    EXPECT_EQ(std::next(placed[0].first), placed[2].first);
+    EXPECT_EQ(std::next(placed[2].first), placed[5].first);
+    EXPECT_EQ(std::next(placed[5].first), my_set.upper_bound(7));
+    EXPECT_EQ(std::next(placed[1].first), placed[4].first);
+    EXPECT_EQ(std::next(placed[3].first), my_set.end());
+  }
+}
+
+TEST(BtreeMapTest, InsertManyAndInsertOrAssign) {
+  s21::btree_map<int, std::string> my_map;
+  for (int i = 0; i < 5000; i += 2) my_map[i] = "old";
+  std::string text(40, 'x');
+  auto placed = my_map.insert_many(
+      std::make_pair(3, text), std::make_pair(2, "no"),
+      std::make_pair(7, "seven"), std::make_pair(3, "again"));
+  EXPECT_TRUE(placed[0].second && placed[2].second);
+  EXPECT_FALSE(placed[1].second || placed[3].second);
+  EXPECT_EQ(placed[0].first->second, text);
+  EXPECT_EQ(placed[1].first->second, "old");
+  EXPECT_EQ(placed[2].first->first, 7);
+  EXPECT_EQ(placed[3].first, placed[0].first);
+
+  s21::btree_map<std::string, std::unique_ptr<int>> owners;
+  std::string key(50, 'k');
+  auto result = owners.insert_or_assign(std::move(key),
+                                        std::make_unique<int>(1));
+  EXPECT_TRUE(result.second);
+  std::string same(50, 'k');
+  result = owners.insert_or_assign(same, std::make_unique<int>(2));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(*result.first->second, 2);
+  EXPECT_EQ(owners.size(), 1U);
+}
+
+TEST(BtreeMapTest, TransparentLookup) {
+  s21::btree_map<std::string, int, std::less<>> my_map;
+  for (int i = 0; i < 1000; ++i) my_map[std::to_string(i)] = i;
+  EXPECT_EQ(my_map.find(std::string_view("42"))->second, 42);
+  EXPECT_TRUE(my_map.contains("999"));
+  EXPECT_EQ(my_map.count("1000"), 0U);
+  EXPECT_EQ(my_map.lower_bound("98z")->first, "99");
+}
+
+// FLAT
+
+TEST(FlatSetTest, MatchesStdSet) {
+  s21::flat_set<int> my_set;
+  std::set<int> std_set;
+  unsigned seed = 1;
+  for (int i = 0; i < 6000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>(seed >> 8) % 2000 - 1000;
+    if (i % 3 == 0) {
+      auto it = my_set.find(key);
+      ASSERT_EQ(it == my_set.end(), std_set.count(key) == 0);
+      if (it != my_set.end()) my_set.erase(it);
+      std_set.erase(key);
+    } else {
+      ASSERT_EQ(my_set.insert(key).second, std_set.insert(key).second);
+    }
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(std_set.begin(), std_set.end(), my_set.begin()));
+  for (int key = -1001; key <= 1001; ++key) {
+    auto lower = std_set.lower_bound(key);
+    auto upper = std_set.upper_bound(key);
+    auto range = my_set.equal_range(key);
+    ASSERT_EQ(range.first == my_set.end(), lower == std_set.end());
+    ASSERT_EQ(range.second == my_set.end(), upper == std_set.end());
+    if (lower != std_set.end()) {
+      ASSERT_EQ(*range.first, *lower);
+    }
+    if (upper != std_set.end()) {
+      ASSERT_EQ(*range.second, *upper);
+    }
+    ASSERT_EQ(my_set.contains(key), std_set.count(key) == 1);
+  }
+}
+
+TEST(FlatSetTest, InsertManyAndMerge) {
+  s21::flat_set<int> my_set{10, 30, 50};
+  auto placed = my_set.insert_many(40, 30, 20, 40, 60);
+  ASSERT_EQ(placed.size(), 5U);
+  bool inserted[] = {true, false, true, false, true};
+  int at[] = {40, 30, 20, 40, 60};
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(placed[i].second, inserted[i]);
+    EXPECT_EQ(*placed[i].first, at[i]);
+  }
+  EXPECT_EQ(my_set.size(), 6U);
+  EXPECT_TRUE(std::is_sorted(my_set.begin(), my_set.end()));
+
+  s21::flat_set<int> other{5, 10, 25, 60, 70};
+  my_set.merge(other);
+  int merged[] = {5, 10, 20, 25, 30, 40, 50, 60, 70};
+  EXPECT_TRUE(std::equal(std::begin(merged), std::end(merged),
+                         my_set.begin(), my_set.end()));
+  int left[] = {10, 60};
+  EXPECT_TRUE(std::equal(std::begin(left), std::end(left), other.begin(),
+                         other.end()));
+
+  std::vector<int> keys;
+  for (int i = 0; i < 10000; ++i) keys.push_back(i * 7919 % 5000);
+  s21::flat_set<int> built(keys.begin(), keys.end());
+  EXPECT_EQ(built.size(), 5000U);
+  EXPECT_EQ(*--built.end(), 4999);
+  built.insert(keys.begin(), keys.end());
+  EXPECT_EQ(built.size(), 5000U);
+}
+
+TEST(FlatMultisetTest, KeepsEqualsInOrder) {
+  s21::flat_multiset<int> my_set{3, 1, 3, 2};
+  std::multiset<int> std_set{3, 1, 3, 2};
+  auto placed = my_set.insert_many(3, 0, 3);
+  std_set.insert({3, 0, 3});
+  EXPECT_TRUE(placed[0].second && placed[1].second && placed[2].second);
+  EXPECT_EQ(placed[2].first - placed[0].first, 1);
+  EXPECT_EQ(placed[2].first + 1, my_set.end());
+  EXPECT_EQ(my_set.count(3), 4U);
+  EXPECT_TRUE(std::equal(std_set.begin(), std_set.end(), my_set.begin(),
+                         my_set.end()));
+  s21::flat_multiset<int> other{3, 5};
+  my_set.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(my_set.count(3), 5U);
+  auto range = my_set.equal_range(3);
+  EXPECT_EQ(range.second - range.first, 5);
+  my_set.erase(range.first);
+  EXPECT_EQ(my_set.count(3), 4U);
+  EXPECT_EQ(*my_set.insert(2).first, 2);
+  EXPECT_EQ(my_set.count(2), 2U);
+}
+
+TEST(FlatMapTest, MapInterface) {
+  s21::flat_map<std::string, int> my_map{{"b", 2}, {"a", 1}, {"b", 9}};
+  EXPECT_EQ(my_map.size(), 2U);
+  EXPECT_EQ(my_map.at("b"), 2);
+  EXPECT_THROW(my_map.at("z"), std::out_of_range);
+  my_map["c"] = 3;
+  ++my_map["a"];
+  EXPECT_FALSE(my_map.insert({"c", 7}).second);
+  EXPECT_FALSE(my_map.insert_or_assign("c", 4).second);
+  EXPECT_TRUE(my_map.try_emplace("d", 5).second);
+  auto placed = my_map.insert_many(std::make_pair("e", 6),
+                                   std::make_pair("a", 0));
+  EXPECT_TRUE(placed[0].second);
+  EXPECT_EQ(placed[0].first->second, 6);
+  EXPECT_FALSE(placed[1].second);
+  EXPECT_EQ(placed[1].first->second, 2);
+  std::map<std::string, int> expected{
+      {"a", 2}, {"b", 2}, {"c", 4}, {"d", 5}, {"e", 6}};
+  ASSERT_EQ(my_map.size(), expected.size());
+  auto it = my_map.begin();
+  for (const auto &[key, value] : expected) {
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  EXPECT_EQ(my_map.find(std::string("d"))->second, 5);
+  EXPECT_EQ(my_map.lower_bound(std::string("bb"))->first, "c");
+  my_map.erase(my_map.find(std::string("c")));
+  EXPECT_FALSE(my_map.contains(std::string("c")));
+  s21::flat_map<std::string, int> other{{"a", 100}, {"z", 26}};
+  my_map.merge(other);
+  EXPECT_EQ(my_map.at("z"), 26);
+  EXPECT_EQ(my_map.at("a"), 2);
+  EXPECT_EQ(other.size(), 1U);
+}
+
+// UNORDERED
+
+TEST(UnorderedSetTest, MatchesStdUnorderedSet) {
+  s21::unordered_set<int> my_set;
+  std::unordered_set<int> std_set;
+  unsigned seed = 7;
+  for (int i = 0; i < 50000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>(seed >> 8) % 3000;
+    if (i % 3 == 0) {
+      auto it = my_set.find(key);
+      ASSERT_EQ(it == my_set.end(), std_set.count(key) == 0);
+      if (it != my_set.end()) my_set.erase(it);
+      std_set.erase(key);
+    } else {
+      ASSERT_EQ(my_set.insert(key).second, std_set.insert(key).second);
+    }
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  std::size_t visited = 0;
+  for (int key : my_set) {
+    ASSERT_EQ(std_set.count(key), 1U);
+    ++visited;
+  }
+  EXPECT_EQ(visited, std_set.size());
+  EXPECT_LE(my_set.load_factor(), my_set.max_load_factor());
+  EXPECT_THROW(my_set.erase(my_set.end()), std::invalid_argument);
+  s21::unordered_set<int> copy(my_set);
+  for (int key : std_set) ASSERT_TRUE(copy.contains(key));
+}
+
+TEST(UnorderedSetTest, ReserveAndClearKeepTheTable) {
+  s21::unordered_set<int, std::hash<int>, std::equal_to<int>,
+                     CountingAllocator<int>>
+      my_set;
+  my_set.reserve(1000);
+  std::size_t buckets = my_set.bucket_count();
+  long calls = CountingAllocator<int>::calls;
+  for (int i = 0; i < 1000; ++i) my_set.insert(i * 31);
+  my_set.clear();
+  EXPECT_TRUE(my_set.empty());
+  EXPECT_EQ(my_set.begin(), my_set.end());
+  for (int i = 0; i < 1000; ++i) my_set.insert(-i);
+  EXPECT_EQ(CountingAllocator<int>::calls, calls);
+  EXPECT_EQ(my_set.bucket_count(), buckets);
+  EXPECT_EQ(my_set.count(-999), 1U);
+  EXPECT_EQ(my_set.count(31), 0U);
+}
+
+TEST(UnorderedMapTest, ElementAccessAndLookup) {
+  s21::unordered_map<std::string, int> my_map = {{"beta", 2}, {"alpha", 1}};
+  my_map["gamma"] = 3;
+  my_map.insert_or_assign("alpha", 10);
+  EXPECT_EQ(my_map.at("alpha"), 10);
+  EXPECT_FALSE(my_map.insert("beta", 20).second);
+  EXPECT_EQ(my_map.try_emplace("delta", 4).first->second, 4);
+  EXPECT_THROW(my_map.at("omega"), std::out_of_range);
+  EXPECT_EQ(my_map.size(), 4U);
+  s21::unordered_map<std::string, int> other = {{"beta", 0}, {"zeta", 6}};
+  my_map.merge(other);
+  EXPECT_EQ(my_map.at("zeta"), 6);
+  EXPECT_EQ(my_map.at("beta"), 2);
+  ASSERT_EQ(other.size(), 1U);
+  EXPECT_EQ(other.begin()->first, "beta");
+  s21::unordered_map<int, int> numbers;
+  std::map<int, int> std_numbers;
+  for (int i = 0; i < 10000; ++i) {
+    numbers[i * 7 % 1000] += i;
+    std_numbers[i * 7 % 1000] += i;
+  }
+  for (const auto &item : std_numbers) {
+    ASSERT_EQ(numbers.at(item.first), item.second);
+  }
+}
+
+TEST(UnorderedSetTest, MergeIntoEmpty) {
+  s21::unordered_set<int> my_set;
+  s21::unordered_set<int> other = {1, 2, 3};
+  my_set.merge(other);
+  EXPECT_EQ(my_set.size(), 3U);
+  EXPECT_TRUE(other.empty());
+  for (int key : {1, 2, 3}) EXPECT_TRUE(my_set.contains(key));
+  s21::unordered_map<std::string, int> my_map;
+  s21::unordered_map<std::string, int> items = {{"a", 1}, {"b", 2}};
+  my_map.merge(items);
+  EXPECT_EQ(my_map.size(), 2U);
+  EXPECT_EQ(my_map.at("b"), 2);
+  EXPECT_TRUE(items.empty());
+}
+
+TEST(UnorderedSetTest, InsertManyKeepsEveryPosition) {
+  s21::unordered_set<int> my_set = {1};
+  auto placed = my_set.insert_many(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+                                   14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+                                   25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35,
+                                   36, 37, 38, 39, 40);
+  ASSERT_EQ(placed.size(), 40U);
+  EXPECT_FALSE(placed[0].second);
+  for (int i = 0; i < 40; ++i) {
+    EXPECT_EQ(*placed[i].first, i + 1);
+    EXPECT_EQ(placed[i].second, i != 0);
+  }
+  EXPECT_EQ(my_set.size(), 40U);
+  s21::unordered_map<int, std::string> my_map;
+  std::string long_text(100, 'x');
+  auto pairs = my_map.insert_many(
+      std::make_pair(1, long_text), std::make_pair(2, "b"),
+      std::make_pair(3, "c"), std::make_pair(4, "d"), std::make_pair(5, "e"),
+      std::make_pair(6, "f"), std::make_pair(7, "g"), std::make_pair(8, "h"),
+      std::make_pair(9, "i"), std::make_pair(10, "j"), std::make_pair(1, ""));
+  ASSERT_EQ(pairs.size(), 11U);
+  EXPECT_EQ(pairs[0].first->second, long_text);
+  EXPECT_EQ(pairs[9].first->first, 10);
+  EXPECT_FALSE(pairs[10].second);
+  EXPECT_EQ(pairs[10].first, pairs[0].first);
+}
+
+TEST(UnorderedMapTest, InsertOrAssignMoves) {
+  s21::unordered_map<std::string, std::unique_ptr<int>> my_map;
+  std::string key(50, 'k');
+  auto result = my_map.insert_or_assign(std::move(key),
+                                        std::make_unique<int>(1));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(*result.first->second, 1);
+  std::string same(50, 'k');
+  result = my_map.insert_or_assign(same, std::make_unique<int>(2));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(*result.first->second, 2);
+  EXPECT_EQ(same, std::string(50, 'k'));
+  EXPECT_EQ(my_map.size(), 1U);
+}
+
+struct StringViewHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view text) const {
+    return std::hash<std::string_view>()(text);
+  }
+};
+
+TEST(UnorderedMapTest, TransparentLookup) {
+  s21::unordered_map<std::string, int, StringViewHash, std::equal_to<>>
+      my_map;
+  for (int i = 0; i < 100; ++i) my_map[std::to_string(i)] = i;
+  EXPECT_EQ(my_map.find(std::string_view("42"))->second, 42);
+  EXPECT_TRUE(my_map.contains("99"));
+  EXPECT_EQ(my_map.count("100"), 0U);
+}
+
+// VECTOR
+
+template <typename value_type, typename Allocator>
+bool compare_vectors(const s21::vector<value_type, Allocator> &my_vector,
+                     const std::vector<value_type> &std_vector) {
+  if (my_vector.size() != std_vector.size()) return false;
+  for (size_t i = 0; i != my_vector.size(); ++i) {
+    if (my_vector[i] != std_vector[i]) return false;
+  }
+  return true;
+}
+
+struct MoveOnly {
+  explicit MoveOnly(int v) : value(new int(v)) {}
+  MoveOnly(MoveOnly &&other) noexcept = default;
+  MoveOnly &operator=(MoveOnly &&other) noexcept = default;
+  std::unique_ptr<int> value;
+};
+
+TEST(VectorTest, Constructors) {
+  s21::vector<int> my_vector;
+  EXPECT_TRUE(my_vector.empty());
+  EXPECT_EQ(my_vector.capacity(), 0U);
+  s21::vector<int> sized(5);
+  EXPECT_TRUE(compare_vectors(sized, std::vector<int>(5)));
+  s21::vector<int> init{1, 2, 3, 4};
+  EXPECT_TRUE(compare_vectors(init, std::vector<int>{1, 2, 3, 4}));
+  s21::vector<int> copy(init);
+  EXPECT_TRUE(compare_vectors(copy, std::vector<int>{1, 2, 3, 4}));
+  s21::vector<int> moved(std::move(copy));
+  EXPECT_TRUE(compare_vectors(moved, std::vector<int>{1, 2, 3, 4}));
+  EXPECT_TRUE(copy.empty());
+  my_vector = std::move(moved);
+  EXPECT_EQ(my_vector.size(), 4U);
+  sized = my_vector;
+  EXPECT_TRUE(compare_vectors(sized, std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST(VectorTest, ElementAccess) {
+  s21::vector<int> my_vector{10, 20, 30};
+  EXPECT_EQ(my_vector.at(1), 20);
+  EXPECT_THROW(my_vector.at(3), std::out_of_range);
+  EXPECT_EQ(my_vector.front(), 10);
+  EXPECT_EQ(my_vector.back(), 30);
+  EXPECT_EQ(*my_vector.data(), 10);
+  my_vector[2] = 5;
+  EXPECT_EQ(*(my_vector.end() - 1), 5);
+}
+
+TEST(VectorTest, GrowthMatchesStd) {
+  s21::vector<int> my_vector;
+  std::vector<int> std_vector;
+  for (int i = 0; i < 1000; ++i) {
+    my_vector.push_back(i);
+    std_vector.push_back(i);
+    ASSERT_EQ(my_vector.capacity(), std_vector.capacity());
+  }
+  EXPECT_TRUE(compare_vectors(my_vector, std_vector));
+  EXPECT_EQ(my_vector.max_size(), std_vector.max_size());
+  my_vector.reserve(5000);
+  EXPECT_EQ(my_vector.capacity(), 5000U);
+  my_vector.shrink_to_fit();
+  EXPECT_EQ(my_vector.capacity(), 1000U);
+  my_vector.clear();
+  EXPECT_EQ(my_vector.capacity(), 1000U);
+  my_vector.shrink_to_fit();
+  EXPECT_EQ(my_vector.capacity(), 0U);
+  EXPECT_THROW(my_vector.reserve(my_vector.max_size() + 1),
+               std::length_error);
+}
+
+TEST(VectorTest, InsertErase) {
+  s21::vector<std::string> my_vector{"b", "d"};
+  std::vector<std::string> std_vector{"b", "d"};
+  auto it = my_vector.insert(my_vector.begin(), "a");
+  std_vector.insert(std_vector.begin(), "a");
+  EXPECT_EQ(*it, "a");
+  my_vector.insert(my_vector.begin() + 2, "c");
+  std_vector.insert(std_vector.begin() + 2, "c");
+  my_vector.insert(my_vector.end(), my_vector[0]);
+  std_vector.insert(std_vector.end(), std_vector[0]);
+  EXPECT_TRUE(compare_vectors(my_vector, std_vector));
+  my_vector.erase(my_vector.begin() + 1);
+  std_vector.erase(std_vector.begin() + 1);
+  my_vector.pop_back();
+  std_vector.pop_back();
+  EXPECT_TRUE(compare_vectors(my_vector, std_vector));
+  EXPECT_THROW(my_vector.erase(my_vector.end()), std::out_of_range);
+}
+
+TEST(VectorTest, PushBackAliasing) {
+  s21::vector<std::string> my_vector{"first"};
+  for (int i = 0; i < 10; ++i) my_vector.push_back(my_vector[0]);
+  for (const auto &item : my_vector) EXPECT_EQ(item, "first");
+}
+
+TEST(VectorTest, MoveOnlyRelocation) {
+  s21::vector<MoveOnly> my_vector;
+  for (int i = 0; i < 100; ++i) my_vector.emplace_back(i);
+  my_vector.insert(my_vector.begin(), MoveOnly(-1));
+  EXPECT_EQ(*my_vector[0].value, -1);
+  EXPECT_EQ(*my_vector[100].value, 99);
+}
+
+TEST(VectorTest, Swap) {
+  s21::vector<int> a{1, 2, 3};
+  s21::vector<int> b{4};
+  a.swap(b);
+  EXPECT_TRUE(compare_vectors(a, std::vector<int>{4}));
+  EXPECT_TRUE(compare_vectors(b, std::vector<int>{1, 2, 3}));
+}
+
+TEST(VectorTest, AlignedStorage) {
+  s21::vector<float, s21::aligned_allocator<float, 64>> my_vector;
+  for (int i = 0; i < 100; ++i) {
+    my_vector.push_back(static_cast<float>(i));
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(my_vector.data()) % 64, 0U);
+  }
+  EXPECT_EQ(my_vector[99], 99.0f);
+}
+
+// QUEUE
+
+TEST(QueueTest, FifoOrder) {
+  s21::queue<int> my_queue{1, 2, 3};
+  std::queue<int> std_queue;
+  for (int i = 1; i <= 3; ++i) std_queue.push(i);
+  for (int i = 4; i < 100; ++i) {
+    my_queue.push(i);
+    std_queue.push(i);
+    if (i % 3 == 0) {
+      my_queue.pop();
+      std_queue.pop();
+    }
+    ASSERT_EQ(my_queue.front(), std_queue.front());
+    ASSERT_EQ(my_queue.back(), std_queue.back());
+    ASSERT_EQ(my_queue.size(), std_queue.size());
+  }
+  EXPECT_EQ(my_queue.capacity() & (my_queue.capacity() - 1), 0U);
+}
+
+TEST(QueueTest, SteadyStateKeepsBuffer) {
+  s21::queue<std::string> my_queue;
+  for (int i = 0; i < 16; ++i) my_queue.push(std::to_string(i));
+  size_t capacity = my_queue.capacity();
+  for (int i = 0; i < 1000; ++i) {
+    std::string value = std::move(my_queue.front());
+    my_queue.pop();
+    my_queue.push(std::move(value));
+  }
+  EXPECT_EQ(my_queue.capacity(), capacity);
+  EXPECT_EQ(my_queue.front(), "8");
+  EXPECT_EQ(my_queue.size(), 16U);
+}
+
+TEST(QueueTest, PushOwnElementWhileGrowing) {
+  s21::queue<std::string> my_queue;
+  my_queue.push("head");
+  for (int i = 0; i < 40; ++i) my_queue.push(my_queue.front());
+  EXPECT_EQ(my_queue.size(), 41U);
+  EXPECT_EQ(my_queue.back(), "head");
+}
+
+TEST(QueueTest, CopyMoveSwap) {
+  s21::queue<int> a{1, 2, 3};
+  s21::queue<int> b(a);
+  a.pop();
+  EXPECT_EQ(b.front(), 1);
+  s21::queue<int> c(std::move(a));
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(c.front(), 2);
+  c.swap(b);
+  EXPECT_EQ(c.size(), 3U);
+  EXPECT_EQ(b.size(), 2U);
+  EXPECT_THROW(a.pop(), std::out_of_range);
+}
+
+TEST(QueueTest, FixedCapacity) {
+  s21::queue<int, 4> my_queue;
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 4; ++i) my_queue.push(round * 4 + i);
+    EXPECT_TRUE(my_queue.full());
+    EXPECT_THROW(my_queue.push(0), std::length_error);
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_EQ(my_queue.front(), round * 4 + i);
+      my_queue.pop();
+    }
+  }
+  s21::queue<int, 4> other{7, 8};
+  my_queue.push(1);
+  my_queue.swap(other);
+  EXPECT_EQ(my_queue.size(), 2U);
+  EXPECT_EQ(other.front(), 1);
+}
+
+TEST(ConcurrentQueueTest, FifoAndBounds) {
+  s21::concurrent_queue<std::string> my_queue(5);
+  EXPECT_EQ(my_queue.capacity(), 8U);
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_TRUE(my_queue.try_push(std::to_string(i)));
+  }
+  std::vector<std::string> more = {"6", "7", "8"};
+  EXPECT_EQ(my_queue.try_push_batch(std::make_move_iterator(more.begin()),
+                                    std::make_move_iterator(more.end())),
+            2U);
+  EXPECT_FALSE(my_queue.try_emplace(3, 'x'));
+  EXPECT_EQ(my_queue.size_approx(), 8U);
+  std::string value;
+  ASSERT_TRUE(my_queue.try_pop(value));
+  EXPECT_EQ(value, "0");
+  std::string batch[10];
+  ASSERT_EQ(my_queue.try_pop_batch(batch, 10), 7U);
+  for (int i = 0; i < 7; ++i) EXPECT_EQ(batch[i], std::to_string(i + 1));
+  EXPECT_FALSE(my_queue.try_pop(value));
+  EXPECT_TRUE(my_queue.try_emplace(3, 'x'));
+}
+
+TEST(ConcurrentQueueTest, FailedPushKeepsTheValue) {
+  s21::concurrent_queue<std::unique_ptr<int>> my_queue(2);
+  ASSERT_TRUE(my_queue.try_push(std::make_unique<int>(1)));
+  ASSERT_TRUE(my_queue.try_push(std::make_unique<int>(2)));
+  auto value = std::make_unique<int>(3);
+  EXPECT_FALSE(my_queue.try_push(std::move(value)));
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 3);
+  std::unique_ptr<int> out;
+  ASSERT_TRUE(my_queue.try_pop(out));
+  EXPECT_EQ(*out, 1);
+  EXPECT_TRUE(my_queue.try_push(std::move(value)));
+  EXPECT_EQ(value, nullptr);
+}
+
+// Every value arrives exactly once, and each consumer sees the values of
+// one producer in the order they were pushed.
+TEST(ConcurrentQueueTest, ManyProducersManyConsumers) {
+  constexpr int kProducers = 4;
+  constexpr int kConsumers = 4;
+  constexpr int kPerProducer = 20000;
+  s21::concurrent_queue<int> my_queue(64);
+  std::vector<std::atomic<int>> seen(kProducers * kPerProducer);
+  std::atomic<int> received{0};
+  std::atomic<bool> ordered{true};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p) {
+    threads.emplace_back([&, p] {
+      int values[4];
+      for (int i = 0; i < kPerProducer;) {
+        std::size_t pushed = 0;
+        if (i % 2 == 0) {
+          int n = std::min(4, kPerProducer - i);
+          for (int k = 0; k < n; ++k) values[k] = p * kPerProducer + i + k;
+          pushed = my_queue.try_push_batch(values, values + n);
+        } else {
+          pushed = my_queue.try_push(p * kPerProducer + i) ? 1 : 0;
+        }
+        if (pushed == 0) std::this_thread::yield();
+        i += static_cast<int>(pushed);
+      }
+    });
+  }
+  for (int c = 0; c < kConsumers; ++c) {
+    threads.emplace_back([&] {
+      std::vector<int> last(kProducers, -1);
+      int values[8];
+      while (received.load() < kProducers * kPerProducer) {
+        std::size_t popped = my_queue.try_pop_batch(values, 8);
+        if (popped == 0) std::this_thread::yield();
+        for (std::size_t k = 0; k < popped; ++k) {
+          int producer = values[k] / kPerProducer;
+          if (values[k] <= last[producer]) ordered = false;
+          last[producer] = values[k];
+          ++seen[values[k]];
+        }
+        received += static_cast<int>(popped);
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  EXPECT_TRUE(ordered);
+  for (auto &count : seen) ASSERT_EQ(count.load(), 1);
+}
+
+// STACK
+
+TEST(StackTest, LifoOrder) {
+  s21::stack<int> my_stack{1, 2, 3};
+  std::stack<int> std_stack;
+  for (int i = 1; i <= 3; ++i) std_stack.push(i);
+  for (int i = 4; i < 100; ++i) {
+    my_stack.push(i);
+    std_stack.push(i);
+    if (i % 3 == 0) {
+      my_stack.pop();
+      std_stack.pop();
+    }
+    ASSERT_EQ(my_stack.top(), std_stack.top());
+    ASSERT_EQ(my_stack.size(), std_stack.size());
+  }
+}
+
+TEST(StackTest, PushOwnElement) {
+  s21::stack<std::string> my_stack;
+  my_stack.push("top");
+  for (int i = 0; i < 20; ++i) my_stack.push(my_stack.top());
+  EXPECT_EQ(my_stack.size(), 21U);
+  EXPECT_EQ(my_stack.top(), "top");
+}
+
+TEST(StackTest, CopyMoveSwap) {
+  s21::stack<int> a{1, 2, 3};
+  s21::stack<int> b(a);
+  a.pop();
+  EXPECT_EQ(b.top(), 3);
+  s21::stack<int> c(std::move(a));
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(c.top(), 2);
+  c.swap(b);
+  EXPECT_EQ(c.size(), 3U);
+  EXPECT_THROW(a.pop(), std::out_of_range);
+}
+
+TEST(StackTest, FixedCapacity) {
+  s21::stack<std::string, 3> my_stack{"a", "b"};
+  my_stack.push("c");
+  EXPECT_TRUE(my_stack.full());
+  EXPECT_THROW(my_stack.push("d"), std::length_error);
+  s21::stack<std::string, 3> moved(std::move(my_stack));
+  EXPECT_TRUE(my_stack.empty());
+  EXPECT_EQ(moved.top(), "c");
+  moved.pop();
+  EXPECT_EQ(moved.top(), "b");
+}
+
+struct MoveCounted {
+  static inline int moves = 0;
+  explicit MoveCounted(int value) : value(value) {}
+  MoveCounted(MoveCounted &&other) noexcept : value(other.value) { ++moves; }
+  int value;
+};
+
+// Growing moves the old elements over once and builds the new one in its
+// slot; a fixed container holds nothing but its slots and counters.
+TEST(StackTest, GrowthBuildsInPlace) {
+  s21::stack<MoveCounted> my_stack;
+  for (int i = 0; i < 8; ++i) my_stack.emplace(i);
+  ASSERT_EQ(my_stack.capacity(), 8U);
+  MoveCounted::moves = 0;
+  EXPECT_EQ(my_stack.emplace(8).value, 8);
+  EXPECT_EQ(MoveCounted::moves, 8);
+  s21::queue<MoveCounted> my_queue;
+  for (int i = 0; i < 10; ++i) my_queue.emplace(i);
+  for (int i = 0; i < 6; ++i) my_queue.pop();
+  for (int i = 10; i < 16; ++i) my_queue.emplace(i);
+  ASSERT_EQ(my_queue.capacity(), 16U);
+  for (int i = 16; i < 22; ++i) my_queue.emplace(i);
+  MoveCounted::moves = 0;
+  EXPECT_EQ(my_queue.emplace(22).value, 22);
+  EXPECT_EQ(MoveCounted::moves, 16);
+  for (int i = 6; i <= 22; ++i) {
+    ASSERT_EQ(my_queue.front().value, i);
+    my_queue.pop();
+  }
+  static_assert(sizeof(s21::stack<int, 4>) ==
+                4 * sizeof(int) + sizeof(std::size_t));
+  static_assert(sizeof(s21::queue<int, 4>) ==
+                4 * sizeof(int) + 2 * sizeof(std::size_t));
+}
+
+TEST(WorkStealingDequeTest, OwnerLifoThiefFifo) {
+  s21::work_stealing_deque<int> tasks(2);
+  int value = 0;
+  EXPECT_FALSE(tasks.try_pop(value));
+  EXPECT_FALSE(tasks.try_steal(value));
+  for (int i = 0; i < 100; ++i) tasks.push(i);
+  EXPECT_GE(tasks.capacity(), 100U);
+  EXPECT_EQ(tasks.size_approx(), 100U);
+  ASSERT_TRUE(tasks.try_pop(value));
+  EXPECT_EQ(value, 99);
+  ASSERT_TRUE(tasks.try_steal(value));
+  EXPECT_EQ(value, 0);
+  for (int i = 98; i >= 1; --i) {
+    ASSERT_TRUE(tasks.try_pop(value));
+    ASSERT_EQ(value, i);
+  }
+  EXPECT_TRUE(tasks.empty());
+  EXPECT_FALSE(tasks.try_pop(value));
+}
+
+// The owner pushes and pops while thieves steal; every task is run by
+// exactly one thread.
+TEST(WorkStealingDequeTest, StealersTakeEachTaskOnce) {
+  constexpr int kTasks = 50000;
+  constexpr int kThieves = 3;
+  s21::work_stealing_deque<int> tasks(4);
+  std::vector<std::atomic<int>> runs(kTasks);
+  std::atomic<int> done{0};
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < kThieves; ++t) {
+    thieves.emplace_back([&] {
+      int task;
+      while (done.load() < kTasks) {
+        if (tasks.try_steal(task)) {
+          ++runs[task];
+          ++done;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  int task;
+  for (int i = 0; i < kTasks; ++i) {
+    tasks.push(i);
+    if (i % 3 == 0 && tasks.try_pop(task)) {
+      ++runs[task];
+      ++done;
+    }
+  }
+  // A pop that loses the last task to a thief leaves out alone.
+  bool kept = true;
+  while (done.load() < kTasks) {
+    task = -1;
+    if (tasks.try_pop(task)) {
+      ++runs[task];
+      ++done;
+    } else {
+      kept = kept && task == -1;
+      std::this_thread::yield();
+    }
+  }
+  for (auto &thief : thieves) thief.join();
+  for (auto &count : runs) ASSERT_EQ(count.load(), 1);
+  EXPECT_TRUE(kept);
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
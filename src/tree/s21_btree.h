@@ -0,0 +1,1036 @@
+#ifndef S21_BTREE_
+#define S21_BTREE_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../allocator/s21_inline_storage.h"
+#include "../s21_type_traits.h"
+#include "s21_compare_holder.h"
+
+namespace s21 {
+
+// B+-tree behind btree_set, btree_multiset and btree_map. Values live in
+// leaves of about kNodeBytes that are chained in order; inner nodes hold
+// only separator keys and children. A node packs dozens of keys, so a
+// lookup touches a few cache lines per level and a handful of levels,
+// where BinaryTree pays three pointers per value and a miss per level.
+// The price is iterator stability: insert and erase move values within
+// and between nodes, so both invalidate every iterator.
+//
+// Separators satisfy children[i] <= keys[i] <= children[i + 1], which
+// lets equal keys of a multiset straddle a separator. KeyOfValue finds the
+// key in a stored value and Compare orders keys, as in BinaryTree.
+template <typename Key, typename T, typename KeyOfValue,
+          typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<T>>
+class BTree : private CompareHolder<Compare> {
+  using Holder = CompareHolder<Compare>;
+
+ public:
+  using key_type = Key;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+
+  // Lets a wrapper take lookups by any K when Compare is transparent.
+  template <typename K>
+  using EnableIfTransparent =
+      std::enable_if_t<IsTransparent<Compare>::value, K>;
+
+  // Four cache lines: wide enough that a leaf of ints holds 56 keys, small
+  // enough that an insert only shifts a few hundred bytes.
+  static constexpr size_type kNodeBytes = 256;
+
+  struct Inner;
+  struct Leaf;
+
+  struct NodeBase {
+    Inner *parent{nullptr};
+    std::uint16_t position{0};  // index among the parent's children
+    std::uint16_t count{0};     // values of a leaf, keys of an inner node
+    bool leaf{false};
+  };
+
+  struct LeafLinks : NodeBase {
+    Leaf *prev{nullptr};
+    Leaf *next{nullptr};
+  };
+
+  static constexpr size_type kLeafSlots = std::max<size_type>(
+      3, (kNodeBytes - sizeof(LeafLinks)) / sizeof(value_type));
+  static constexpr size_type kInnerSlots = std::max<size_type>(
+      3, (kNodeBytes - sizeof(NodeBase) - sizeof(void *)) /
+             (sizeof(Key) + sizeof(void *)));
+  static_assert(kLeafSlots <= std::numeric_limits<std::uint16_t>::max() &&
+                    kInnerSlots < std::numeric_limits<std::uint16_t>::max(),
+                "node counts must fit 16 bits");
+
+  struct alignas(64) Leaf : LeafLinks {
+    InlineStorage<value_type, kLeafSlots> slots;
+    value_type *values() { return slots.get(); }
+    const value_type *values() const { return slots.get(); }
+  };
+
+  struct alignas(64) Inner : NodeBase {
+    NodeBase *children[kInnerSlots + 1] = {};
+    InlineStorage<Key, kInnerSlots> slots;
+    Key *keys() { return slots.get(); }
+    const Key *keys() const { return slots.get(); }
+  };
+
+  // A leaf and a slot in it. end() is one past the last value of the last
+  // leaf, so --end() is an ordinary step back.
+  class iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    iterator() = default;
+    reference operator*() const { return leaf_->values()[index_]; }
+    pointer operator->() const { return &**this; }
+    iterator &operator++() {
+      if (++index_ == leaf_->count && leaf_->next != nullptr) {
+        leaf_ = leaf_->next;
+        index_ = 0;
+      }
+      return *this;
+    }
+    iterator &operator--() {
+      if (index_ == 0) {
+        leaf_ = leaf_->prev;
+        index_ = leaf_->count;
+      }
+      --index_;
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator it(*this);
+      ++(*this);
+      return it;
+    }
+    iterator operator--(int) {
+      iterator it(*this);
+      --(*this);
+      return it;
+    }
+    bool operator==(const iterator &other) const {
+      return leaf_ == other.leaf_ && index_ == other.index_;
+    }
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+   private:
+    friend class BTree;
+    iterator(Leaf *leaf, size_type index) : leaf_(leaf), index_(index) {}
+
+    Leaf *leaf_{nullptr};
+    size_type index_{0};
+  };
+  using const_iterator = iterator;
+
+  BTree() = default;
+  explicit BTree(const Allocator &alloc) : alloc_(alloc) {}
+  explicit BTree(const Compare &comp, const Allocator &alloc = Allocator())
+      : Holder(comp), alloc_(alloc) {}
+  BTree(const BTree &other)
+      : Holder(other),
+        alloc_(std::allocator_traits<Allocator>::
+                   select_on_container_copy_construction(other.alloc_)) {
+    if (other.root_ == nullptr) return;
+    Leaf *prev = nullptr;
+    try {
+      root_ = CopyNode(other.root_, nullptr, prev);
+    } catch (...) {
+      clear();
+      throw;
+    }
+    last_ = prev;
+    size_ = other.size_;
+  }
+  BTree(BTree &&other) noexcept : Holder(other), alloc_(other.alloc_) {
+    swap(other);
+  }
+  ~BTree() { clear(); }
+  BTree &operator=(BTree &&other) {
+    clear();
+    swap(other);
+    return *this;
+  }
+
+  iterator begin() const noexcept { return iterator(first_, 0); }
+  iterator end() const noexcept {
+    return iterator(last_, last_ != nullptr ? last_->count : 0);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+  allocator_type get_allocator() const { return alloc_; }
+  key_compare key_comp() const { return Holder::Comp(); }
+
+  void clear() noexcept {
+    if (root_ != nullptr) ClearNode(root_);
+    root_ = nullptr;
+    first_ = last_ = nullptr;
+    size_ = 0;
+  }
+
+  void swap(BTree &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(first_, other.first_);
+    std::swap(last_, other.last_);
+    std::swap(size_, other.size_);
+    std::swap(alloc_, other.alloc_);
+    Holder::SwapComp(other);
+  }
+
+  std::pair<iterator, bool> InsertValue(const value_type &value,
+                                        bool duplicate) {
+    return InsertKeyed(KeyOfValue::KeyOf(value), duplicate, value);
+  }
+  std::pair<iterator, bool> InsertValue(value_type &&value, bool duplicate) {
+    return InsertKeyed(KeyOfValue::KeyOf(value), duplicate, std::move(value));
+  }
+
+  // The key is only known once the value exists, so it is built on the
+  // stack and moved into its slot.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(bool duplicate, Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return InsertValue(std::move(value), duplicate);
+  }
+
+  // Builds the value in its slot, and only when key is absent
+  // (map::try_emplace).
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(K &&key, Args &&...args) {
+    return InsertKeyed(key, false, std::piecewise_construct,
+                       std::forward_as_tuple(std::forward<K>(key)),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // Assigns obj to the mapped value of an equal key, otherwise builds the
+  // value in its slot (map::insert_or_assign). obj is only forwarded once.
+  template <typename K, typename M>
+  std::pair<iterator, bool> InsertOrAssign(K &&key, M &&obj) {
+    auto result = TryEmplace(std::forward<K>(key), std::forward<M>(obj));
+    if (!result.second) result.first->second = std::forward<M>(obj);
+    return result;
+  }
+
+  // Sorts [first, last) once and builds the tree bottom up in O(n) when it
+  // is empty; otherwise the values go in one by one.
+  template <typename InputIt>
+  void InsertRange(InputIt first, InputIt last, bool duplicate) {
+    if (!empty()) {
+      for (; first != last; ++first) Emplace(duplicate, *first);
+      return;
+    }
+    std::vector<value_type> values(first, last);
+    std::vector<value_type *> order;
+    order.reserve(values.size());
+    for (value_type &value : values) order.push_back(&value);
+    auto less = [this](const value_type *a, const value_type *b) {
+      return KeyLess(a, b);
+    };
+    if (!std::is_sorted(order.begin(), order.end(), less)) {
+      std::stable_sort(order.begin(), order.end(), less);
+    }
+    if (!duplicate) {
+      order.erase(std::unique(order.begin(), order.end(),
+                              [this](const value_type *a, const value_type *b) {
+                                return !KeyLess(a, b);
+                              }),
+                  order.end());
+    }
+    BuildSorted(order);
+  }
+
+  // Builds a value from every argument, sorts them and puts them in like
+  // merge, then reports in argument order the position each one took, or
+  // that of the equal value that kept it out, and whether it went in. Any
+  // insert moves values, so positions are only looked up at the end: from
+  // copies of the keys when the values went in one by one, by rank in the
+  // merged sequence when the tree was rebuilt.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> InsertMany(bool duplicate,
+                                                    Args &&...args) {
+    std::vector<value_type> values;
+    values.reserve(sizeof...(args));
+    (values.emplace_back(std::forward<Args>(args)), ...);
+    size_type n = values.size();
+    std::vector<size_type> order(n);
+    std::iota(order.begin(), order.end(), size_type(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [this, &values](size_type a, size_type b) {
+                       return KeyLess(&values[a], &values[b]);
+                     });
+    std::vector<std::pair<iterator, bool>> result(n);
+    if (n * FloorLog2(size_ + n) < size_) {
+      std::vector<Key> keys;
+      keys.reserve(n);
+      for (size_type i : order) {
+        keys.push_back(KeyOfValue::KeyOf(values[i]));
+        result[i].second = InsertValue(std::move(values[i]), duplicate).second;
+      }
+      // Equal values of a multiset went in after their equals, in order.
+      for (size_type first = 0, last; first != n; first = last) {
+        last = first + 1;
+        iterator it;
+        if (duplicate) {
+          while (last != n && !Less(keys[first], keys[last])) ++last;
+          it = UpperBound(keys[first]);
+          for (size_type i = first; i != last; ++i) --it;
+        } else {
+          it = Find(keys[first]);
+        }
+        for (size_type i = first; i != last; ++i, ++it) {
+          result[order[i]].first = it;
+        }
+      }
+      return result;
+    }
+    std::vector<size_type> ranks(n);
+    std::vector<value_type *> taken;
+    taken.reserve(size_ + n);
+    iterator mine = begin();
+    for (size_type i : order) {
+      value_type *value = &values[i];
+      for (; mine != end() && !KeyLess(value, &*mine); ++mine) {
+        taken.push_back(&*mine);
+      }
+      result[i].second =
+          duplicate || taken.empty() || KeyLess(taken.back(), value);
+      if (result[i].second) taken.push_back(value);
+      ranks[i] = taken.size() - 1;
+    }
+    for (; mine != end(); ++mine) taken.push_back(&*mine);
+    BTree merged(Holder::Comp(), alloc_);
+    merged.BuildSorted(taken);
+    swap(merged);
+    iterator it = begin();
+    size_type rank = 0;
+    for (size_type i : order) {
+      for (; rank != ranks[i]; ++rank) ++it;
+      result[i].first = it;
+    }
+    return result;
+  }
+
+  // Moves every value of other whose key is not here (any value with
+  // duplicate) into this tree; the rest stay in other. Both trees are
+  // rebuilt from one linear merge unless other is much smaller.
+  void merge(BTree &other, bool duplicate = false) {
+    if (this == &other || other.empty()) return;
+    std::vector<value_type *> taken;
+    std::vector<value_type *> rejected;
+    if (other.size_ * FloorLog2(size_ + other.size_) < size_) {
+      for (value_type &value : other) {
+        if (!duplicate && Find(KeyOfValue::KeyOf(value)) != end()) {
+          rejected.push_back(&value);
+        } else {
+          InsertValue(std::move(value), true);
+        }
+      }
+    } else {
+      taken.reserve(size_ + other.size_);
+      iterator mine = begin();
+      for (value_type &value : other) {
+        for (; mine != end() && !KeyLess(&value, &*mine); ++mine) {
+          taken.push_back(&*mine);
+        }
+        if (!duplicate && !taken.empty() && !KeyLess(taken.back(), &value)) {
+          rejected.push_back(&value);
+        } else {
+          taken.push_back(&value);
+        }
+      }
+      for (; mine != end(); ++mine) taken.push_back(&*mine);
+      BTree merged(Holder::Comp(), alloc_);
+      merged.BuildSorted(taken);
+      swap(merged);
+    }
+    BTree rest(other.Comp(), other.alloc_);
+    rest.BuildSorted(rejected);
+    other.swap(rest);
+  }
+
+  void erase(iterator pos) {
+    Leaf *leaf = pos.leaf_;
+    if (leaf == nullptr || pos.index_ >= leaf->count) {
+      throw std::invalid_argument("wrong argument");
+    }
+    value_type *values = leaf->values();
+    Destroy(values + pos.index_);
+    Relocate(values + pos.index_, values + pos.index_ + 1,
+             leaf->count - pos.index_ - 1);
+    --leaf->count;
+    --size_;
+    Rebalance(leaf);
+  }
+
+  template <typename K>
+  iterator Find(const K &key) const {
+    iterator it = LowerBound(key);
+    if (it != end() && Less(key, KeyOfValue::KeyOf(*it))) return end();
+    return it;
+  }
+
+  template <typename K>
+  iterator LowerBound(const K &key) const {
+    if (root_ == nullptr) return end();
+    auto [leaf, index] = Descend<false>(key);
+    return Normalized(leaf, index);
+  }
+
+  template <typename K>
+  iterator UpperBound(const K &key) const {
+    if (root_ == nullptr) return end();
+    auto [leaf, index] = Descend<true>(key);
+    return Normalized(leaf, index);
+  }
+
+  template <typename K>
+  std::pair<iterator, iterator> EqualRange(const K &key) const {
+    return {LowerBound(key), UpperBound(key)};
+  }
+
+  template <typename K>
+  size_type Count(const K &key) const {
+    size_type counter = 0;
+    auto range = EqualRange(key);
+    for (iterator it = range.first; it != range.second; ++it) ++counter;
+    return counter;
+  }
+
+ private:
+  using leaf_traits = typename std::allocator_traits<
+      Allocator>::template rebind_traits<Leaf>;
+  using inner_traits = typename std::allocator_traits<
+      Allocator>::template rebind_traits<Inner>;
+  using value_traits = std::allocator_traits<Allocator>;
+
+  static constexpr size_type kMaxHeight = 64;
+
+  // Finds the slot for key (after its equals with duplicate) and builds
+  // the value there from args, unless duplicate is off and key is taken.
+  // key is not used once the value is being built.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> InsertKeyed(const K &key, bool duplicate,
+                                        Args &&...args) {
+    Leaf *leaf;
+    size_type index;
+    if (root_ == nullptr) {
+      leaf = first_ = last_ = NewLeaf();
+      root_ = leaf;
+      index = 0;
+    } else if (duplicate) {
+      std::tie(leaf, index) = Descend<true>(key);
+    } else {
+      std::tie(leaf, index) = Descend<false>(key);
+      iterator found = Normalized(leaf, index);
+      if (found != end() && !Less(key, KeyOfValue::KeyOf(*found))) {
+        return {found, false};
+      }
+    }
+    return {InsertAt(leaf, index, std::forward<Args>(args)...), true};
+  }
+
+  // Leaf and slot of the first value not less than key (with kUpper,
+  // greater than key). The slot may be one past the end of its leaf.
+  template <bool kUpper, typename K>
+  std::pair<Leaf *, size_type> Descend(const K &key) const {
+    NodeBase *node = root_;
+    while (!node->leaf) {
+      Inner *inner = static_cast<Inner *>(node);
+      node = inner->children[Search<kUpper>(inner->keys(), inner->count, key)];
+    }
+    Leaf *leaf = static_cast<Leaf *>(node);
+    return {leaf, Search<kUpper>(leaf->values(), leaf->count, key)};
+  }
+
+  // One past the end of a leaf is the start of the next one; only the last
+  // leaf keeps it, as end().
+  static iterator Normalized(Leaf *leaf, size_type index) {
+    if (index == leaf->count && leaf->next != nullptr) {
+      return iterator(leaf->next, 0);
+    }
+    return iterator(leaf, index);
+  }
+
+  template <typename V>
+  static const Key &KeyAt(const V *slots, size_type index) {
+    if constexpr (std::is_same_v<V, Key>) {
+      return slots[index];
+    } else {
+      return KeyOfValue::KeyOf(slots[index]);
+    }
+  }
+
+  // Index of the first of the n sorted slots whose key is not less than
+  // key, or with kUpper greater than key. The SSE2 path orders keys by <,
+  // so it is only taken when Compare is std::less.
+  template <bool kUpper, typename V, typename K>
+  size_type Search(const V *slots, size_type n, const K &key) const {
+#if defined(__SSE2__)
+    if constexpr (std::is_same_v<V, Key> && std::is_same_v<K, Key> &&
+                  std::is_integral_v<Key> && sizeof(Key) == 4 &&
+                  (std::is_same_v<Compare, std::less<Key>> ||
+                   std::is_same_v<Compare, std::less<>>)) {
+      return SearchSse2<kUpper>(slots, n, key);
+    }
+#endif
+    size_type low = 0;
+    size_type high = n;
+    while (low < high) {
+      size_type mid = (low + high) / 2;
+      bool before = kUpper ? !Less(key, KeyAt(slots, mid))
+                           : Less(KeyAt(slots, mid), key);
+      if (before) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+#if defined(__SSE2__)
+  // Compares four 32-bit keys at a time. Unsigned keys get their sign bit
+  // flipped so the signed compare orders them. Since the keys are sorted,
+  // the index is simply how many of them lie before key, so every block is
+  // counted without a data-dependent branch to mispredict.
+  template <bool kUpper>
+  static size_type SearchSse2(const Key *keys, size_type n, Key key) {
+    const __m128i flip = _mm_set1_epi32(
+        std::is_signed_v<Key> ? 0 : std::numeric_limits<std::int32_t>::min());
+    const __m128i target =
+        _mm_xor_si128(_mm_set1_epi32(static_cast<std::int32_t>(key)), flip);
+    __m128i hits = _mm_setzero_si128();
+    size_type i = 0;
+    for (; i + 4 <= n; i += 4) {
+      __m128i block = _mm_xor_si128(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), flip);
+      // Lanes after key for kUpper, before it otherwise; each is -1.
+      hits = _mm_sub_epi32(hits, kUpper ? _mm_cmpgt_epi32(block, target)
+                                        : _mm_cmpgt_epi32(target, block));
+    }
+    hits = _mm_add_epi32(hits, _mm_shuffle_epi32(hits, 0x4E));
+    hits = _mm_add_epi32(hits, _mm_shuffle_epi32(hits, 0xB1));
+    size_type counted = static_cast<size_type>(_mm_cvtsi128_si32(hits));
+    size_type index = kUpper ? i - counted : counted;
+    if (index == i) {
+      while (index < n && (kUpper ? !(key < keys[index]) : keys[index] < key)) {
+        ++index;
+      }
+    }
+    return index;
+  }
+#endif
+
+  template <typename A, typename B>
+  bool Less(const A &a, const B &b) const {
+    return Holder::Comp()(a, b);
+  }
+
+  bool KeyLess(const value_type *a, const value_type *b) const {
+    return Less(KeyOfValue::KeyOf(*a), KeyOfValue::KeyOf(*b));
+  }
+
+  static size_type FloorLog2(size_type n) {
+    size_type log = 0;
+    while (n > 1) {
+      n >>= 1;
+      ++log;
+    }
+    return log;
+  }
+
+  // Moves n objects from from to the raw slots at to and leaves from raw.
+  // The ranges may overlap either way.
+  template <typename V>
+  static void Relocate(V *to, V *from, size_type n) {
+    if constexpr (std::is_trivially_copyable_v<V>) {
+      if (n != 0) std::memmove(static_cast<void *>(to), from, n * sizeof(V));
+    } else if (to < from) {
+      for (size_type i = 0; i != n; ++i) {
+        ::new (static_cast<void *>(to + i)) V(std::move(from[i]));
+        from[i].~V();
+      }
+    } else {
+      for (size_type i = n; i-- != 0;) {
+        ::new (static_cast<void *>(to + i)) V(std::move(from[i]));
+        from[i].~V();
+      }
+    }
+  }
+
+  void Destroy(value_type *value) {
+    Allocator alloc(alloc_);
+    value_traits::destroy(alloc, value);
+  }
+
+  Leaf *NewLeaf() {
+    typename leaf_traits::allocator_type alloc(alloc_);
+    Leaf *leaf = leaf_traits::allocate(alloc, 1);
+    ::new (static_cast<void *>(leaf)) Leaf();
+    leaf->leaf = true;
+    return leaf;
+  }
+
+  Inner *NewInner() {
+    typename inner_traits::allocator_type alloc(alloc_);
+    Inner *inner = inner_traits::allocate(alloc, 1);
+    ::new (static_cast<void *>(inner)) Inner();
+    return inner;
+  }
+
+  void FreeNode(NodeBase *node) {
+    if (node->leaf) {
+      typename leaf_traits::allocator_type alloc(alloc_);
+      leaf_traits::deallocate(alloc, static_cast<Leaf *>(node), 1);
+    } else {
+      typename inner_traits::allocator_type alloc(alloc_);
+      inner_traits::deallocate(alloc, static_cast<Inner *>(node), 1);
+    }
+  }
+
+  // Destroys what the node holds and frees it with its subtree. The height
+  // is logarithmic with a large base, so recursion is shallow.
+  void ClearNode(NodeBase *node) noexcept {
+    if (node->leaf) {
+      Leaf *leaf = static_cast<Leaf *>(node);
+      for (size_type i = 0; i != leaf->count; ++i) Destroy(leaf->values() + i);
+    } else {
+      Inner *inner = static_cast<Inner *>(node);
+      for (size_type i = 0; i != inner->count; ++i) inner->keys()[i].~Key();
+      for (NodeBase *child : inner->children) {
+        if (child != nullptr) ClearNode(child);
+      }
+    }
+    FreeNode(node);
+  }
+
+  // Copies source under parent. prev is the last leaf copied so far, so
+  // the leaves are chained in order as they are made.
+  NodeBase *CopyNode(const NodeBase *source, Inner *parent, Leaf *&prev) {
+    if (source->leaf) {
+      const Leaf *from = static_cast<const Leaf *>(source);
+      Leaf *leaf = NewLeaf();
+      Attach(leaf, parent, source->position);
+      leaf->prev = prev;
+      (prev != nullptr ? prev->next : first_) = leaf;
+      prev = leaf;
+      Allocator alloc(alloc_);
+      for (; leaf->count != from->count; ++leaf->count) {
+        value_traits::construct(alloc, leaf->values() + leaf->count,
+                                from->values()[leaf->count]);
+      }
+      return leaf;
+    }
+    const Inner *from = static_cast<const Inner *>(source);
+    Inner *inner = NewInner();
+    Attach(inner, parent, source->position);
+    for (; inner->count != from->count; ++inner->count) {
+      ::new (static_cast<void *>(inner->keys() + inner->count))
+          Key(from->keys()[inner->count]);
+    }
+    for (size_type i = 0; i <= from->count; ++i) {
+      CopyNode(from->children[i], inner, prev);
+    }
+    return inner;
+  }
+
+  // Hangs node as child position of parent, or makes it the root.
+  void Attach(NodeBase *node, Inner *parent, size_type position) {
+    node->parent = parent;
+    node->position = static_cast<std::uint16_t>(position);
+    if (parent != nullptr) {
+      parent->children[position] = node;
+    } else {
+      root_ = node;
+    }
+  }
+
+  // Builds the tree, which must be empty, from sorted values by moving
+  // them into leaves filled left to right and laying each level of
+  // separators over the one below. Leaves and inner nodes are spread
+  // evenly, so all of them are at least half full.
+  void BuildSorted(const std::vector<value_type *> &values) {
+    if (values.empty()) return;
+    size_type leaves = (values.size() + kLeafSlots - 1) / kLeafSlots;
+    size_type inner_total = 0;
+    for (size_type n = leaves; n > 1;) {
+      n = (n + kInnerSlots) / (kInnerSlots + 1);
+      inner_total += n;
+    }
+    std::vector<NodeBase *> level;
+    std::vector<const Key *> lows;
+    std::vector<Inner *> inners;
+    level.reserve(leaves);
+    lows.reserve(leaves);
+    inners.reserve(inner_total);
+    Allocator alloc(alloc_);
+    try {
+      auto next = values.begin();
+      for (size_type i = 0; i != leaves; ++i) {
+        Leaf *leaf = NewLeaf();
+        leaf->prev = last_;
+        (last_ != nullptr ? last_->next : first_) = leaf;
+        last_ = leaf;
+        level.push_back(leaf);
+        size_type take = values.size() * (i + 1) / leaves -
+                         values.size() * i / leaves;
+        for (; leaf->count != take; ++leaf->count, ++next) {
+          value_traits::construct(alloc, leaf->values() + leaf->count,
+                                  std::move(**next));
+        }
+        lows.push_back(&KeyOfValue::KeyOf(leaf->values()[0]));
+      }
+      while (level.size() > 1) {
+        size_type parents = (level.size() + kInnerSlots) / (kInnerSlots + 1);
+        std::vector<NodeBase *> upper;
+        std::vector<const Key *> upper_lows;
+        upper.reserve(parents);
+        upper_lows.reserve(parents);
+        for (size_type i = 0; i != parents; ++i) {
+          size_type from = level.size() * i / parents;
+          size_type to = level.size() * (i + 1) / parents;
+          Inner *inner = NewInner();
+          inners.push_back(inner);
+          upper.push_back(inner);
+          upper_lows.push_back(lows[from]);
+          for (size_type child = from + 1; child != to; ++child) {
+            ::new (static_cast<void *>(inner->keys() + inner->count))
+                Key(*lows[child]);
+            ++inner->count;
+          }
+          for (size_type child = from; child != to; ++child) {
+            Attach(level[child], inner, child - from);
+          }
+        }
+        level.swap(upper);
+        lows.swap(upper_lows);
+      }
+    } catch (...) {
+      // The leaves are all on the chain and the inner nodes in inners, so
+      // each is freed on its own without walking half-built links.
+      for (Leaf *leaf = first_; leaf != nullptr;) {
+        Leaf *next = leaf->next;
+        ClearNode(leaf);
+        leaf = next;
+      }
+      for (Inner *inner : inners) {
+        std::fill(std::begin(inner->children), std::end(inner->children),
+                  nullptr);
+        ClearNode(inner);
+      }
+      first_ = last_ = nullptr;
+      throw;
+    }
+    size_ = values.size();
+    level.front()->parent = nullptr;
+    root_ = level.front();
+  }
+
+  // Is node the first (or last) one on its level?
+  static bool OnEdge(const NodeBase *node, bool right) {
+    for (; node->parent != nullptr; node = node->parent) {
+      if (node->position != (right ? node->parent->count : 0)) return false;
+    }
+    return true;
+  }
+
+  // Where to cut a full node of count entries that is about to get one
+  // more at index: in half, except at the ends of the tree, where sorted
+  // input keeps arriving and a lopsided cut leaves the nodes behind full.
+  static size_type SplitPoint(const NodeBase *node, size_type index,
+                              size_type count) {
+    if (index == count && OnEdge(node, true)) return count - 1;
+    if (index == 0 && OnEdge(node, false)) return 1;
+    return count / 2;
+  }
+
+  // Constructs the value at index of leaf, splitting the leaf and its
+  // full ancestors first. Every node the splits need is allocated up
+  // front, so a failed allocation leaves the tree as it was.
+  template <typename... Args>
+  iterator InsertAt(Leaf *leaf, size_type index, Args &&...args) {
+    if (leaf->count == kLeafSlots) {
+      // A sibling for every full ancestor and a root if they all are.
+      size_type needed = 0;
+      NodeBase *node = leaf->parent;
+      for (; node != nullptr && node->count == kInnerSlots;
+           node = node->parent) {
+        ++needed;
+      }
+      if (node == nullptr) ++needed;
+      Inner *spare[kMaxHeight];
+      size_type spares = 0;
+      Leaf *right = NewLeaf();
+      try {
+        while (spares != needed) spare[spares++] = NewInner();
+      } catch (...) {
+        while (spares != 0) FreeNode(spare[--spares]);
+        FreeNode(right);
+        throw;
+      }
+      Inner **next_spare = spare;
+      size_type keep = SplitPoint(leaf, index, leaf->count);
+      Relocate(right->values(), leaf->values() + keep, leaf->count - keep);
+      right->count = static_cast<std::uint16_t>(leaf->count - keep);
+      leaf->count = static_cast<std::uint16_t>(keep);
+      right->prev = leaf;
+      right->next = leaf->next;
+      (leaf->next != nullptr ? leaf->next->prev : last_) = right;
+      leaf->next = right;
+      InsertChild(leaf, KeyOfValue::KeyOf(right->values()[0]), right,
+                  next_spare);
+      while (next_spare != spare + spares) FreeNode(*next_spare++);
+      if (index > keep) {
+        index -= keep;
+        leaf = right;
+      }
+    }
+    value_type *values = leaf->values();
+    Relocate(values + index + 1, values + index, leaf->count - index);
+    try {
+      Allocator alloc(alloc_);
+      value_traits::construct(alloc, values + index,
+                              std::forward<Args>(args)...);
+    } catch (...) {
+      Relocate(values + index, values + index + 1, leaf->count - index);
+      Rebalance(leaf);
+      throw;
+    }
+    ++leaf->count;
+    ++size_;
+    return iterator(leaf, index);
+  }
+
+  // Puts right just after left under left's parent with key between them,
+  // splitting full inner nodes on the way up and growing a new root when
+  // the old one splits. The nodes come from spare.
+  void InsertChild(NodeBase *left, Key key, NodeBase *right,
+                   Inner **&spare) {
+    while (true) {
+      Inner *parent = left->parent;
+      if (parent == nullptr) {
+        Inner *root = *spare++;
+        ::new (static_cast<void *>(root->keys())) Key(std::move(key));
+        root->count = 1;
+        Attach(left, root, 0);
+        Attach(right, root, 1);
+        root_ = root;
+        return;
+      }
+      size_type index = left->position;
+      if (parent->count != kInnerSlots) {
+        InsertIntoInner(parent, index, std::move(key), right);
+        return;
+      }
+      Inner *sibling = *spare++;
+      size_type keep = SplitPoint(parent, index, parent->count);
+      Key *keys = parent->keys();
+      Key up(std::move(keys[keep]));
+      keys[keep].~Key();
+      size_type moved = parent->count - keep - 1;
+      Relocate(sibling->keys(), keys + keep + 1, moved);
+      for (size_type i = 0; i <= moved; ++i) {
+        Attach(parent->children[keep + 1 + i], sibling, i);
+        parent->children[keep + 1 + i] = nullptr;
+      }
+      sibling->count = static_cast<std::uint16_t>(moved);
+      parent->count = static_cast<std::uint16_t>(keep);
+      if (index <= keep) {
+        InsertIntoInner(parent, index, std::move(key), right);
+      } else {
+        InsertIntoInner(sibling, index - keep - 1, std::move(key), right);
+      }
+      left = parent;
+      key = std::move(up);
+      right = sibling;
+    }
+  }
+
+  // Inserts key at index and child just after it into a node with room.
+  void InsertIntoInner(Inner *inner, size_type index, Key &&key,
+                       NodeBase *child) {
+    Relocate(inner->keys() + index + 1, inner->keys() + index,
+             inner->count - index);
+    ::new (static_cast<void *>(inner->keys() + index)) Key(std::move(key));
+    for (size_type i = inner->count + 1; i > index + 1; --i) {
+      Attach(inner->children[i - 1], inner, i);
+    }
+    Attach(child, inner, index + 1);
+    ++inner->count;
+  }
+
+  // Drops key index of inner and the child right after it.
+  void RemoveFromInner(Inner *inner, size_type index) {
+    inner->keys()[index].~Key();
+    Relocate(inner->keys() + index, inner->keys() + index + 1,
+             inner->count - index - 1);
+    for (size_type i = index + 1; i != inner->count; ++i) {
+      Attach(inner->children[i + 1], inner, i);
+    }
+    inner->children[inner->count] = nullptr;
+    --inner->count;
+  }
+
+  // Restores the fill of a node that just lost an entry: an underfull node
+  // merges with a neighbour when both fit in one node and takes entries
+  // from it otherwise. Merging removes a separator, so it may cascade up.
+  void Rebalance(NodeBase *node) {
+    while (true) {
+      if (node == root_) {
+        if (node->count == 0) {
+          if (node->leaf) {
+            root_ = nullptr;
+            first_ = last_ = nullptr;
+          } else {
+            root_ = static_cast<Inner *>(node)->children[0];
+            root_->parent = nullptr;
+            root_->position = 0;
+          }
+          FreeNode(node);
+        }
+        return;
+      }
+      size_type slots = node->leaf ? kLeafSlots : kInnerSlots;
+      if (node->count >= slots / 2) return;
+      Inner *parent = node->parent;
+      size_type separator = node->position != 0 ? node->position - 1 : 0;
+      NodeBase *left = parent->children[separator];
+      NodeBase *right = parent->children[separator + 1];
+      size_type joined = left->count + right->count + (node->leaf ? 0 : 1);
+      if (joined > slots) {
+        if (node->leaf) {
+          ShareLeaves(static_cast<Leaf *>(left), static_cast<Leaf *>(right),
+                      parent, separator);
+        } else {
+          ShareInner(static_cast<Inner *>(left), static_cast<Inner *>(right),
+                     parent, separator);
+        }
+        return;
+      }
+      if (node->leaf) {
+        MergeLeaves(static_cast<Leaf *>(left), static_cast<Leaf *>(right));
+      } else {
+        MergeInner(static_cast<Inner *>(left), static_cast<Inner *>(right),
+                   parent, separator);
+      }
+      RemoveFromInner(parent, separator);
+      FreeNode(right);
+      node = parent;
+    }
+  }
+
+  void MergeLeaves(Leaf *left, Leaf *right) {
+    Relocate(left->values() + left->count, right->values(), right->count);
+    left->count = static_cast<std::uint16_t>(left->count + right->count);
+    right->count = 0;
+    left->next = right->next;
+    (right->next != nullptr ? right->next->prev : last_) = left;
+  }
+
+  // Pulls the separator down between the keys of left and right.
+  void MergeInner(Inner *left, Inner *right, Inner *parent,
+                  size_type separator) {
+    Key *keys = left->keys();
+    ::new (static_cast<void *>(keys + left->count))
+        Key(std::move(parent->keys()[separator]));
+    Relocate(keys + left->count + 1, right->keys(), right->count);
+    for (size_type i = 0; i <= right->count; ++i) {
+      Attach(right->children[i], left, left->count + 1 + i);
+    }
+    left->count = static_cast<std::uint16_t>(left->count + 1 + right->count);
+    right->count = 0;
+  }
+
+  // Evens out two neighbouring leaves; the separator becomes the new first
+  // key of right.
+  void ShareLeaves(Leaf *left, Leaf *right, Inner *parent,
+                   size_type separator) {
+    if (left->count > right->count) {
+      size_type n = (left->count - right->count) / 2;
+      Relocate(right->values() + n, right->values(), right->count);
+      Relocate(right->values(), left->values() + left->count - n, n);
+      left->count = static_cast<std::uint16_t>(left->count - n);
+      right->count = static_cast<std::uint16_t>(right->count + n);
+    } else {
+      size_type n = (right->count - left->count) / 2;
+      Relocate(left->values() + left->count, right->values(), n);
+      Relocate(right->values(), right->values() + n, right->count - n);
+      left->count = static_cast<std::uint16_t>(left->count + n);
+      right->count = static_cast<std::uint16_t>(right->count - n);
+    }
+    parent->keys()[separator] = KeyOfValue::KeyOf(right->values()[0]);
+  }
+
+  // Rotates keys through the separator until the two nodes are even.
+  void ShareInner(Inner *left, Inner *right, Inner *parent,
+                  size_type separator) {
+    Key &middle = parent->keys()[separator];
+    while (left->count + 1 < right->count) {
+      ::new (static_cast<void *>(left->keys() + left->count))
+          Key(std::move(middle));
+      middle = std::move(right->keys()[0]);
+      right->keys()[0].~Key();
+      Relocate(right->keys(), right->keys() + 1, right->count - 1);
+      Attach(right->children[0], left, left->count + 1);
+      for (size_type i = 0; i != right->count; ++i) {
+        Attach(right->children[i + 1], right, i);
+      }
+      right->children[right->count] = nullptr;
+      ++left->count;
+      --right->count;
+    }
+    while (right->count + 1 < left->count) {
+      Relocate(right->keys() + 1, right->keys(), right->count);
+      ::new (static_cast<void *>(right->keys())) Key(std::move(middle));
+      middle = std::move(left->keys()[left->count - 1]);
+      left->keys()[left->count - 1].~Key();
+      for (size_type i = right->count + 1; i != 0; --i) {
+        Attach(right->children[i - 1], right, i);
+      }
+      Attach(left->children[left->count], right, 0);
+      left->children[left->count] = nullptr;
+      --left->count;
+      ++right->count;
+    }
+  }
+
+  NodeBase *root_{nullptr};
+  Leaf *first_{nullptr};
+  Leaf *last_{nullptr};
+  size_type size_{0};
+  Allocator alloc_;
+};
+}  // namespace s21
+
+#endif  // S21_BTREE_
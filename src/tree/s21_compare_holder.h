@@ -0,0 +1,40 @@
+#ifndef S21_COMPARE_HOLDER_
+#define S21_COMPARE_HOLDER_
+
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Holds a tree's comparator. An empty one such as std::less is a base
+// class, so it takes no space; anything else, a function pointer or a
+// comparator with state, is a member.
+template <typename Compare,
+          bool = std::is_empty_v<Compare> && !std::is_final_v<Compare>>
+class CompareHolder : private Compare {
+ public:
+  CompareHolder() = default;
+  explicit CompareHolder(const Compare &comp) : Compare(comp) {}
+
+  const Compare &Comp() const noexcept { return *this; }
+  void SwapComp(CompareHolder &) noexcept {}
+};
+
+template <typename Compare>
+class CompareHolder<Compare, false> {
+ public:
+  CompareHolder() = default;
+  explicit CompareHolder(const Compare &comp) : comp_(comp) {}
+
+  const Compare &Comp() const noexcept { return comp_; }
+  void SwapComp(CompareHolder &other) noexcept {
+    std::swap(comp_, other.comp_);
+  }
+
+ private:
+  Compare comp_{};
+};
+
+}  // namespace s21
+
+#endif  // S21_COMPARE_HOLDER_
@@ -0,0 +1,271 @@
+#ifndef S21_FLAT_TREE_H
+#define S21_FLAT_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// The values of a set, multiset or map kept sorted in one contiguous
+// array. Lookups are a binary search over it and iteration is a pointer
+// walk, which beats any node tree on reads. A single insert or erase
+// shifts the tail of the array, so values are best added in batches:
+// InsertRange, InsertMany and merge sort the new values once and merge
+// them with the stored ones in one linear pass.
+//
+// Any insert or erase invalidates iterators and references.
+template <typename Key, typename T, typename Comparator,
+          typename Allocator = std::allocator<T>>
+class FlatTree {
+ public:
+  using key_type = Key;
+  using value_type = T;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using storage_type = std::vector<value_type, Allocator>;
+  using iterator = typename storage_type::iterator;
+  using const_iterator = typename storage_type::const_iterator;
+
+  FlatTree() = default;
+  explicit FlatTree(const Allocator &alloc) : values_(alloc) {}
+
+  iterator begin() const noexcept { return Values().begin(); }
+  iterator end() const noexcept { return Values().end(); }
+
+  bool empty() const noexcept { return values_.empty(); }
+  size_type size() const noexcept { return values_.size(); }
+  size_type max_size() const noexcept { return values_.max_size(); }
+  allocator_type get_allocator() const { return values_.get_allocator(); }
+
+  void clear() noexcept { values_.clear(); }
+  void swap(FlatTree &other) noexcept { values_.swap(other.values_); }
+  void Reserve(size_type n) { values_.reserve(n); }
+
+  template <typename V>
+  std::pair<iterator, bool> InsertValue(V &&value, bool duplicate) {
+    const Key &key = Comparator::KeyOf(value);
+    size_type index = duplicate ? Search<true>(key) : Search<false>(key);
+    if (!duplicate && Holds(index, key)) return {begin() + index, false};
+    return {values_.insert(values_.begin() + index, std::forward<V>(value)),
+            true};
+  }
+
+  // The key is only known once the value exists, so it is built on the
+  // stack and moved into its slot.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(bool duplicate, Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return InsertValue(std::move(value), duplicate);
+  }
+
+  // Builds the value only when key is absent (map::try_emplace).
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(K &&key, Args &&...args) {
+    size_type index = Search<false>(key);
+    if (Holds(index, key)) return {begin() + index, false};
+    return {values_.emplace(
+                values_.begin() + index, std::piecewise_construct,
+                std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...)),
+            true};
+  }
+
+  std::pair<iterator, bool> InsertOrAssign(const value_type &value) {
+    auto result = InsertValue(value, false);
+    if (!result.second) result.first->second = value.second;
+    return result;
+  }
+
+  // Inserts [first, last) with one sort and one merge. Equal keys keep
+  // their input order; without duplicate the first one wins.
+  template <typename InputIt>
+  void InsertRange(InputIt first, InputIt last, bool duplicate) {
+    storage_type batch(first, last, get_allocator());
+    if (!std::is_sorted(batch.begin(), batch.end(), KeyLess)) {
+      std::stable_sort(batch.begin(), batch.end(), KeyLess);
+    }
+    MergeSorted(batch, duplicate, nullptr, nullptr);
+  }
+
+  // Inserts every argument like InsertRange and reports, in argument
+  // order, where each value ended up (or the equal one that kept it out)
+  // and whether it went in. The positions are only taken after the merge,
+  // so all of them are valid.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> InsertMany(bool duplicate,
+                                                    Args &&...args) {
+    storage_type values(get_allocator());
+    values.reserve(sizeof...(args));
+    (values.emplace_back(std::forward<Args>(args)), ...);
+    std::vector<size_type> order(values.size());
+    std::iota(order.begin(), order.end(), size_type(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&values](size_type a, size_type b) {
+                       return KeyLess(values[a], values[b]);
+                     });
+    storage_type batch(get_allocator());
+    batch.reserve(values.size());
+    for (size_type i : order) batch.push_back(std::move(values[i]));
+    std::vector<std::pair<size_type, bool>> placed;
+    MergeSorted(batch, duplicate, nullptr, &placed);
+    std::vector<std::pair<iterator, bool>> result(order.size());
+    for (size_type i = 0; i != order.size(); ++i) {
+      result[order[i]] = {begin() + placed[i].first, placed[i].second};
+    }
+    return result;
+  }
+
+  // Moves every value of other whose key is not here (any value with
+  // duplicate) into this tree in one merge; the rest stay in other.
+  void merge(FlatTree &other, bool duplicate = false) {
+    if (this == &other || other.empty()) return;
+    storage_type batch(get_allocator());
+    batch.swap(other.values_);
+    MergeSorted(batch, duplicate, &other.values_, nullptr);
+  }
+
+  iterator erase(const_iterator pos) {
+    if (pos == values_.cend()) {
+      throw std::invalid_argument("wrong argument");
+    }
+    return values_.erase(pos);
+  }
+
+  template <typename K>
+  iterator Find(const K &key) const {
+    size_type index = Search<false>(key);
+    return Holds(index, key) ? begin() + index : end();
+  }
+  template <typename K>
+  iterator LowerBound(const K &key) const {
+    return begin() + Search<false>(key);
+  }
+  template <typename K>
+  iterator UpperBound(const K &key) const {
+    return begin() + Search<true>(key);
+  }
+  template <typename K>
+  std::pair<iterator, iterator> EqualRange(const K &key) const {
+    return {LowerBound(key), UpperBound(key)};
+  }
+  template <typename K>
+  size_type Count(const K &key) const {
+    return Search<true>(key) - Search<false>(key);
+  }
+
+ private:
+  storage_type &Values() const {
+    return const_cast<storage_type &>(values_);
+  }
+
+  static bool KeyLess(const value_type &a, const value_type &b) {
+    return Comparator::KeyOf(a) < Comparator::KeyOf(b);
+  }
+
+  template <bool kUpper, typename K>
+  static bool Before(const value_type &value, const K &key) {
+    if constexpr (kUpper) {
+      return !(key < Comparator::KeyOf(value));
+    } else {
+      return Comparator::KeyOf(value) < key;
+    }
+  }
+
+  // Index of the first value whose key is not less than key, or with
+  // kUpper greater than key. Each step halves the range and moves its base
+  // by the compare result times the half, so no branch waits on a compare
+  // that is right only half the time. The loop runs log2(n) times for any
+  // key.
+  template <bool kUpper, typename K>
+  size_type Search(const K &key) const {
+    const value_type *values = values_.data();
+    size_type n = values_.size();
+    if (n == 0) return 0;
+    size_type base = 0;
+    while (n > 1) {
+      size_type half = n / 2;
+#if defined(__GNUC__)
+      // Both places the next probe can land, so the load is under way
+      // whichever way this compare goes.
+      size_type next = (n - half) / 2;
+      __builtin_prefetch(values + base + next);
+      __builtin_prefetch(values + base + half + next);
+#endif
+      base += static_cast<size_type>(
+                  Before<kUpper>(values[base + half - 1], key)) *
+              half;
+      n -= half;
+    }
+    return base + Before<kUpper>(values[base], key);
+  }
+
+  template <typename K>
+  bool Holds(size_type index, const K &key) const {
+    return index != values_.size() &&
+           !(key < Comparator::KeyOf(values_[index]));
+  }
+
+  // Merges the sorted batch into the stored values. Only the values from
+  // where the first batch key goes onwards move, so a batch past the end
+  // is appended in O(k). Without duplicate a value whose key is already
+  // stored, or came earlier in the batch, is moved to rejected (or dropped
+  // when that is null). placed, when given, receives for every batch value
+  // its final index, or that of the equal value that kept it out, and
+  // whether it went in. Equal keys put the stored values first.
+  void MergeSorted(storage_type &batch, bool duplicate,
+                   storage_type *rejected,
+                   std::vector<std::pair<size_type, bool>> *placed) {
+    if (batch.empty()) return;
+    const Key &first = Comparator::KeyOf(batch.front());
+    size_type split = duplicate ? Search<true>(first) : Search<false>(first);
+    // Grows geometrically, as push_back would: an exact reserve per batch
+    // would copy the whole array every time.
+    if (values_.capacity() - values_.size() < batch.size()) {
+      values_.reserve(std::max(values_.size() + batch.size(),
+                               2 * values_.capacity()));
+    }
+    if (placed != nullptr) placed->reserve(batch.size());
+    storage_type tail(std::make_move_iterator(values_.begin() + split),
+                      std::make_move_iterator(values_.end()),
+                      get_allocator());
+    values_.erase(values_.begin() + split, values_.end());
+    auto stored = tail.begin();
+    for (auto &value : batch) {
+      const Key &key = Comparator::KeyOf(value);
+      while (stored != tail.end() &&
+             (duplicate ? !(key < Comparator::KeyOf(*stored))
+                        : Comparator::KeyOf(*stored) < key)) {
+        values_.push_back(std::move(*stored++));
+      }
+      bool taken_by_stored = !duplicate && stored != tail.end() &&
+                             !(key < Comparator::KeyOf(*stored));
+      bool taken_by_batch = !duplicate && !taken_by_stored &&
+                            !values_.empty() && !KeyLess(values_.back(), value);
+      if (taken_by_stored || taken_by_batch) {
+        if (placed != nullptr) {
+          placed->emplace_back(values_.size() - taken_by_batch, false);
+        }
+        if (rejected != nullptr) rejected->push_back(std::move(value));
+        continue;
+      }
+      if (placed != nullptr) placed->emplace_back(values_.size(), true);
+      values_.push_back(std::move(value));
+    }
+    for (; stored != tail.end(); ++stored) {
+      values_.push_back(std::move(*stored));
+    }
+  }
+
+  storage_type values_;
+};
+
+}  // namespace s21
+
+#endif  // S21_FLAT_TREE_H
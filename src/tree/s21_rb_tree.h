@@ -0,0 +1,298 @@
+#ifndef S21_RB_TREE_H
+#define S21_RB_TREE_H
+
+namespace s21 {
+
+// Links and colour of a red-black tree node, shared by BinaryTree and the
+// hook of intrusive_set. A tree hangs off a header of this type: its
+// parent is the root, left and right are the first and last nodes, and it
+// is the end() position, so iterators move by pointers alone and --end()
+// works. An empty tree's header has no parent and points at itself.
+struct RbNode {
+  enum class Color { kRed, kBlack };
+
+  RbNode *left{nullptr};
+  RbNode *right{nullptr};
+  RbNode *parent{nullptr};
+  Color color{Color::kRed};
+};
+
+// The red-black link algorithms. They never look at a value, so every
+// tree type runs the same code and compares keys only while searching.
+class RbTree {
+ public:
+  static RbNode *Minimum(RbNode *node) {
+    if (node != nullptr) {
+      while (node->left) node = node->left;
+    }
+    return node;
+  }
+
+  static RbNode *Maximum(RbNode *node) {
+    if (node != nullptr) {
+      while (node->right) node = node->right;
+    }
+    return node;
+  }
+
+  // Climbs by links, not by keys: rotations and duplicates make the key
+  // order of a node and its parent unreliable. From the last node the
+  // climb ends on the header.
+  static RbNode *Next(RbNode *node) {
+    if (node->right) {
+      node = node->right;
+      while (node->left) node = node->left;
+    } else {
+      RbNode *parent = node->parent;
+      while (node == parent->right) {
+        node = parent;
+        parent = parent->parent;
+      }
+      // Only false when node is the header reached from a root without a
+      // right subtree.
+      if (node->right != parent) node = parent;
+    }
+    return node;
+  }
+
+  // The header is the only red node whose grandparent is itself, or the
+  // only one without a parent when the tree is empty; from it the step
+  // back is the last node.
+  static RbNode *Prev(RbNode *node) {
+    if (node->color == RbNode::Color::kRed &&
+        (node->parent == nullptr || node->parent->parent == node)) {
+      node = node->right;
+    } else if (node->left) {
+      node = node->left;
+      while (node->right) node = node->right;
+    } else {
+      RbNode *parent = node->parent;
+      while (node == parent->left) {
+        node = parent;
+        parent = parent->parent;
+      }
+      node = parent;
+    }
+    return node;
+  }
+
+  // Hangs node in an empty slot, keeping the header's first and last
+  // links current, and rebalances. In an empty tree parent is the header.
+  static void Link(RbNode *node, RbNode *parent, bool to_left,
+                   RbNode &header) {
+    node->left = node->right = nullptr;
+    node->color = RbNode::Color::kRed;
+    node->parent = parent;
+    if (parent == &header) {
+      header.parent = header.left = header.right = node;
+    } else if (to_left) {
+      parent->left = node;
+      if (parent == header.left) header.left = node;
+    } else {
+      parent->right = node;
+      if (parent == header.right) header.right = node;
+    }
+    BalanceInsert(node, header);
+  }
+
+  // Unlinks node from the tree and restores the red-black invariants.
+  // Other nodes keep their addresses, so iterators to them stay valid.
+  static void Unlink(RbNode *node, RbNode &header) {
+    if (node == header.left) {
+      header.left = node->right ? Minimum(node->right) : node->parent;
+    }
+    if (node == header.right) {
+      header.right = node->left ? Maximum(node->left) : node->parent;
+    }
+    RbNode *child = nullptr;
+    RbNode *child_parent = nullptr;
+    RbNode::Color removed_color = node->color;
+    if (node->left == nullptr) {
+      child = node->right;
+      child_parent = node->parent;
+      Transplant(node, node->right, header);
+    } else if (node->right == nullptr) {
+      child = node->left;
+      child_parent = node->parent;
+      Transplant(node, node->left, header);
+    } else {
+      RbNode *next = Minimum(node->right);
+      removed_color = next->color;
+      child = next->right;
+      if (next->parent == node) {
+        child_parent = next;
+      } else {
+        child_parent = next->parent;
+        Transplant(next, next->right, header);
+        next->right = node->right;
+        next->right->parent = next;
+      }
+      Transplant(node, next, header);
+      next->left = node->left;
+      next->left->parent = next;
+      next->color = node->color;
+    }
+    if (removed_color == RbNode::Color::kBlack) {
+      BalanceErase(child, child_parent, header);
+    }
+    if (header.parent == nullptr) header.left = header.right = &header;
+  }
+
+ private:
+  static bool IsRed(const RbNode *node) {
+    return node != nullptr && node->color == RbNode::Color::kRed;
+  }
+
+  static void RotateLeft(RbNode *node, RbNode &header) {
+    RbNode *pivot = node->right;
+    node->right = pivot->left;
+    if (pivot->left != nullptr) pivot->left->parent = node;
+    pivot->parent = node->parent;
+    if (node == header.parent) {
+      header.parent = pivot;
+    } else if (node == node->parent->left) {
+      node->parent->left = pivot;
+    } else {
+      node->parent->right = pivot;
+    }
+    pivot->left = node;
+    node->parent = pivot;
+  }
+
+  static void RotateRight(RbNode *node, RbNode &header) {
+    RbNode *pivot = node->left;
+    node->left = pivot->right;
+    if (pivot->right != nullptr) pivot->right->parent = node;
+    pivot->parent = node->parent;
+    if (node == header.parent) {
+      header.parent = pivot;
+    } else if (node == node->parent->right) {
+      node->parent->right = pivot;
+    } else {
+      node->parent->left = pivot;
+    }
+    pivot->right = node;
+    node->parent = pivot;
+  }
+
+  // Replaces the subtree rooted at old_node with the one rooted at new_node.
+  static void Transplant(RbNode *old_node, RbNode *new_node, RbNode &header) {
+    if (old_node == header.parent) {
+      header.parent = new_node;
+    } else if (old_node == old_node->parent->left) {
+      old_node->parent->left = new_node;
+    } else {
+      old_node->parent->right = new_node;
+    }
+    if (new_node != nullptr) new_node->parent = old_node->parent;
+  }
+
+  // Fixes a red node that was just linked under a possibly red parent.
+  static void BalanceInsert(RbNode *node, RbNode &header) {
+    using Color = RbNode::Color;
+    while (node != header.parent && IsRed(node->parent)) {
+      RbNode *parent = node->parent;
+      RbNode *grandparent = parent->parent;
+      if (parent == grandparent->left) {
+        RbNode *uncle = grandparent->right;
+        if (IsRed(uncle)) {
+          parent->color = Color::kBlack;
+          uncle->color = Color::kBlack;
+          grandparent->color = Color::kRed;
+          node = grandparent;
+        } else {
+          if (node == parent->right) {
+            node = parent;
+            RotateLeft(node, header);
+            parent = node->parent;
+          }
+          parent->color = Color::kBlack;
+          grandparent->color = Color::kRed;
+          RotateRight(grandparent, header);
+        }
+      } else {
+        RbNode *uncle = grandparent->left;
+        if (IsRed(uncle)) {
+          parent->color = Color::kBlack;
+          uncle->color = Color::kBlack;
+          grandparent->color = Color::kRed;
+          node = grandparent;
+        } else {
+          if (node == parent->left) {
+            node = parent;
+            RotateRight(node, header);
+            parent = node->parent;
+          }
+          parent->color = Color::kBlack;
+          grandparent->color = Color::kRed;
+          RotateLeft(grandparent, header);
+        }
+      }
+    }
+    header.parent->color = Color::kBlack;
+  }
+
+  // Restores the black height after a black node was removed. node may be
+  // nullptr (an empty leaf), so its parent is tracked separately.
+  static void BalanceErase(RbNode *node, RbNode *parent, RbNode &header) {
+    using Color = RbNode::Color;
+    while (node != header.parent && !IsRed(node)) {
+      if (node == parent->left) {
+        RbNode *sibling = parent->right;
+        if (IsRed(sibling)) {
+          sibling->color = Color::kBlack;
+          parent->color = Color::kRed;
+          RotateLeft(parent, header);
+          sibling = parent->right;
+        }
+        if (!IsRed(sibling->left) && !IsRed(sibling->right)) {
+          sibling->color = Color::kRed;
+          node = parent;
+          parent = node->parent;
+        } else {
+          if (!IsRed(sibling->right)) {
+            sibling->left->color = Color::kBlack;
+            sibling->color = Color::kRed;
+            RotateRight(sibling, header);
+            sibling = parent->right;
+          }
+          sibling->color = parent->color;
+          parent->color = Color::kBlack;
+          if (sibling->right) sibling->right->color = Color::kBlack;
+          RotateLeft(parent, header);
+          node = header.parent;
+        }
+      } else {
+        RbNode *sibling = parent->left;
+        if (IsRed(sibling)) {
+          sibling->color = Color::kBlack;
+          parent->color = Color::kRed;
+          RotateRight(parent, header);
+          sibling = parent->left;
+        }
+        if (!IsRed(sibling->left) && !IsRed(sibling->right)) {
+          sibling->color = Color::kRed;
+          node = parent;
+          parent = node->parent;
+        } else {
+          if (!IsRed(sibling->left)) {
+            sibling->right->color = Color::kBlack;
+            sibling->color = Color::kRed;
+            RotateLeft(sibling, header);
+            sibling = parent->left;
+          }
+          sibling->color = parent->color;
+          parent->color = Color::kBlack;
+          if (sibling->left) sibling->left->color = Color::kBlack;
+          RotateRight(parent, header);
+          node = header.parent;
+        }
+      }
+    }
+    if (node != nullptr) node->color = Color::kBlack;
+  }
+};
+
+}  // namespace s21
+
+#endif  // S21_RB_TREE_H
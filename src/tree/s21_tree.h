@@ -1,13 +1,34 @@
 #ifndef S21_TREE_
 #define S21_TREE_
 
+#include <algorithm>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <tuple>
 #include <type_traits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../allocator/s21_node_pool.h"
+#include "../s21_type_traits.h"
+#include "s21_compare_holder.h"
+#include "s21_rb_tree.h"
 
 namespace s21 {
 
-template <typename Key, typename T, typename Comparator>
-class BinaryTree {
+// The red-black engine of set, multiset and map. KeyOfValue finds the key
+// in a stored value and Compare orders keys; both are template arguments,
+// so every comparison inlines.
+template <typename Key, typename T, typename KeyOfValue,
+          typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<T>>
+class BinaryTree : private CompareHolder<Compare> {
+  using Holder = CompareHolder<Compare>;
+
  public:
   class Node;
   class BinaryTreeIterator;
@@ -16,57 +37,45 @@ class BinaryTree {
   using value_type = T;
   using reference = T &;
   using const_reference = const value_type &;
-  using iterator = BinaryTree<Key, T, Comparator>::BinaryTreeIterator;
-  using const_iterator =
-      BinaryTree<Key, T, Comparator>::BinaryTreeConstIterator;
+  using iterator = BinaryTreeIterator;
+  using const_iterator = BinaryTreeConstIterator;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+
+  // Lets a wrapper take lookups by any K when Compare is transparent, as
+  // std::map does.
+  template <typename K>
+  using EnableIfTransparent =
+      std::enable_if_t<IsTransparent<Compare>::value, K>;
 
-  class Node {
+  using NodeBase = RbNode;
+  using Color = RbNode::Color;
+
+  class Node : public NodeBase {
    public:
-    Node *left;
-    Node *right;
-    Node *parent;
     value_type data;
-    Node() {
-      left = nullptr;
-      right = nullptr;
-      parent = nullptr;
-    }
-    explicit Node(const value_type &data = value_type{}, Node *left = nullptr,
-                  Node *right = nullptr, Node *parent = nullptr)
-        : left(left), right(right), parent(parent), data(data) {}
+    // The value is constructed in place from whatever the caller forwards.
+    template <typename... Args>
+    explicit Node(Args &&...args) : data(std::forward<Args>(args)...) {}
   };
 
   class BinaryTreeIterator {
    public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
     BinaryTreeIterator() : current(nullptr) {}
-    explicit BinaryTreeIterator(Node *current) : current(current) {}
+    explicit BinaryTreeIterator(NodeBase *current) : current(current) {}
     BinaryTreeIterator &operator++() {
-      if (current) {
-        if (current->right) {
-          current = current->right;
-          while (current->left) current = current->left;
-        } else {
-          while (current->parent && current->data >= current->parent->data) {
-            current = current->parent;
-          }
-          current = current->parent;
-        }
-      }
+      current = RbTree::Next(current);
       return *this;
     }
     BinaryTreeIterator &operator--() {
-      if (current) {
-        if (current->left) {
-          current = current->left;
-          while (current->right) current = current->right;
-        } else {
-          while (current->parent && current->data < current->parent->data) {
-            current = current->parent;
-          }
-          current = current->parent;
-        }
-      }
+      current = RbTree::Prev(current);
       return *this;
     }
     BinaryTreeIterator operator++(int) {
@@ -89,18 +98,19 @@ class BinaryTree {
       if (!current) {
         throw std::invalid_argument("wrong argument");
       }
-      return current->data;
+      return static_cast<Node *>(current)->data;
     }
-    Node *getCurrent() { return current; }
+    T *operator->() const { return &**this; }
+    NodeBase *getCurrent() const { return current; }
 
    private:
-    Node *current{nullptr};
+    NodeBase *current{nullptr};
   };
 
   class BinaryTreeConstIterator : public BinaryTreeIterator {
    public:
     BinaryTreeConstIterator();
-    explicit BinaryTreeConstIterator(Node *current);
+    explicit BinaryTreeConstIterator(NodeBase *current);
     BinaryTreeConstIterator(const BinaryTreeIterator &it);
 
     BinaryTreeConstIterator &operator++();
@@ -115,17 +125,29 @@ class BinaryTree {
     BinaryTreeIterator it;
   };
 
-  BinaryTree() : root(nullptr) {}
-  // BinaryTree(std::initializer_list<value_type> const &items);  // ?
-  BinaryTree(const BinaryTree<Key, T, Comparator> &s) {
-    root = new Node(s.root->data);
-    root->parent = nullptr;
-    CopyTree(root, s.root);
+  BinaryTree() : size_(0) {}
+  explicit BinaryTree(const Allocator &alloc) : size_(0), pool_(alloc) {}
+  BinaryTree(const Compare &comp, const Allocator &alloc)
+      : Holder(comp), size_(0), pool_(alloc) {}
+  BinaryTree(const BinaryTree &s)
+      : Holder(s),
+        pool_(std::allocator_traits<node_allocator>::
+                  select_on_container_copy_construction(
+                      s.pool_.get_allocator())) {
+    if (s.empty()) return;
+    pool_.Reserve(s.size_);
+    try {
+      CopyTree(s.header_.parent);
+    } catch (...) {
+      clear();
+      throw;
+    }
+    size_ = s.size_;
   }
-  BinaryTree(BinaryTree &&s) { swap(s); }
+  BinaryTree(BinaryTree &&s) : Holder(s) { swap(s); }
   // destructor
   ~BinaryTree() {
-    if (root != nullptr) {
+    if (!empty()) {
       clear();
     }
   }
@@ -137,242 +159,658 @@ class BinaryTree {
   }
 
   // Tree Iterators
-  iterator begin() const noexcept {
-    Node *tmp = root;
-    while (tmp->left) {
-      tmp = tmp->left;
+  iterator begin() const noexcept { return iterator(header_.left); }
+  iterator end() const noexcept { return iterator(Header()); }
+
+  // Tree Capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(Node) / 2;
+  }
+  // Tree Modifiers
+  // Destroys every value and hands the slabs back in one go.
+  void clear() noexcept {
+    if (header_.parent != nullptr) ClearTree();
+    pool_.Release();
+    ResetHeader();
+    size_ = 0;
+  }
+
+  allocator_type get_allocator() const {
+    return allocator_type(pool_.get_allocator());
+  }
+  key_compare key_comp() const { return Holder::Comp(); }
+
+  void Insert(const value_type &value, bool duplicate = false) {
+    InsertBool(value, duplicate);
+  }
+  void Insert(value_type &&value, bool duplicate = false) {
+    InsertBool(std::move(value), duplicate);
+  }
+
+  // Assigns obj to the mapped value of an equal key, otherwise builds the
+  // node in place like TryEmplace (map::insert_or_assign).
+  template <typename K, typename M>
+  std::pair<iterator, bool> InsertOrAssign(K &&key, M &&obj) {
+    NodeBase *parent = nullptr;
+    bool to_left = false;
+    Node *found = FindSlot(key, false, parent, to_left);
+    if (found != nullptr) {
+      found->data.second = std::forward<M>(obj);
+      return {iterator(found), false};
     }
-    return iterator(tmp);
+    Node *node = pool_.New(std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<M>(obj)));
+    LinkNode(node, parent, to_left);
+    return {iterator(node), true};
   }
-  iterator end() const noexcept {
-    Node *tmp = root;
-    while (tmp->right) {
-      tmp = tmp->right;
+
+  std::pair<iterator, bool> InsertBool(const value_type &value,
+                                       bool duplicate = false) {
+    return InsertValue(value, duplicate);
+  }
+  std::pair<iterator, bool> InsertBool(value_type &&value,
+                                       bool duplicate = false) {
+    return InsertValue(std::move(value), duplicate);
+  }
+
+  // Builds the value only when key is absent (map::try_emplace).
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(K &&key, Args &&...args) {
+    NodeBase *parent = nullptr;
+    bool to_left = false;
+    Node *found = FindSlot(key, false, parent, to_left);
+    if (found != nullptr) {
+      return {iterator(found), false};
     }
-    return iterator(tmp->right);
+    Node *node = pool_.New(std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+    LinkNode(node, parent, to_left);
+    return {iterator(node), true};
   }
 
-  // Tree Capacity
-  bool empty() const noexcept { return (!root); }
-  size_type size() const noexcept {
-    size_type counter = 0;
-    if (root) {
-      for (auto it = begin(); it != end(); ++it) {
-        ++counter;
-      }
+  // The key is only known once the value exists, so the node is built
+  // first and given back to the pool if an equal key is already present.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(bool duplicate, Args &&...args) {
+    Node *node = pool_.New(std::forward<Args>(args)...);
+    NodeBase *parent = nullptr;
+    bool to_left = false;
+    Node *found =
+        FindSlot(KeyOfValue::KeyOf(node->data), duplicate, parent, to_left);
+    if (found != nullptr) {
+      pool_.Delete(node);
+      return {iterator(found), false};
     }
-    return counter;
+    LinkNode(node, parent, to_left);
+    return {iterator(node), true};
   }
 
-  size_type max_size() const noexcept {
-    return std::numeric_limits<size_type>::max() / sizeof(Node) / 2;
+  // Links the new node right before hint without a descent when it belongs
+  // there, otherwise falls back to a normal insert.
+  template <typename... Args>
+  std::pair<iterator, bool> EmplaceHint(iterator hint, bool duplicate,
+                                        Args &&...args) {
+    Node *node = pool_.New(std::forward<Args>(args)...);
+    NodeBase *parent = nullptr;
+    bool to_left = false;
+    const Key &key = KeyOfValue::KeyOf(node->data);
+    Node *found = nullptr;
+    if (!FitsBefore(hint.getCurrent(), key, duplicate, true, parent,
+                    to_left)) {
+      found = FindSlot(key, duplicate, parent, to_left);
+    }
+    if (found != nullptr) {
+      pool_.Delete(node);
+      return {iterator(found), false};
+    }
+    LinkNode(node, parent, to_left);
+    return {iterator(node), true};
   }
-  // Tree Modifiers
-  void clear() noexcept { ClearTree(root); }
 
-  void Insert(value_type value, bool duplicate = false) {
-    Insert(root, value, duplicate);
+  void erase(iterator pos) {
+    if (pos.getCurrent() == nullptr || pos.getCurrent() == Header())
+      throw std::invalid_argument("wrong argument");
+    delete_node(static_cast<Node *>(pos.getCurrent()));
   }
 
-  void Insert(Node *node, value_type value, bool duplicate = false) {
-    if (root == nullptr) {
-      root = new Node(value);
-      root->parent = nullptr;
-      return;
+  // Unlinks and frees the node. Other nodes keep their addresses, so
+  // iterators stay valid.
+  void delete_node(Node *node) {
+    RbTree::Unlink(node, header_);
+    pool_.Delete(node);
+    --size_;
+  }
+
+  // The headers stay put; only their links are exchanged and the roots
+  // pointed back at their new header.
+  void swap(BinaryTree &other) {
+    std::swap(header_.parent, other.header_.parent);
+    std::swap(header_.left, other.header_.left);
+    std::swap(header_.right, other.header_.right);
+    std::swap(size_, other.size_);
+    pool_.swap(other.pool_);
+    Holder::SwapComp(other);
+    AdoptNodes();
+    other.AdoptNodes();
+  }
+  // Moves the nodes of other into this tree like std::set::merge: no
+  // value is copied and nodes whose key is already here (when duplicates
+  // are not allowed) stay behind in other. Runs in O(n + m), or
+  // O(m log n) when other is much smaller. Afterwards the two pools co-own
+  // the slabs both had, and each tree may still go to its own thread.
+  void merge(BinaryTree &other, bool duplicate = false) {
+    if (this == &other || other.empty()) return;
+    pool_.Share(other.pool_);
+    std::vector<Node *> nodes = other.Flatten();
+    for (Node *node : nodes) node->parent = nullptr;
+    std::vector<Node *> rejected;
+    try {
+      LinkSorted(nodes, duplicate, rejected);
+    } catch (...) {
+      // The nodes linked before a compare threw stay here.
+      rejected.clear();
+      for (Node *node : nodes) {
+        if (node->parent == nullptr) rejected.push_back(node);
+      }
+      other.Rebuild(rejected);
+      throw;
     }
-    if (value < node->data) {
-      if (node->left == nullptr) {
-        node->left = new Node(value);
-        node->left->parent = node;
-      } else {
-        Insert(node->left, value);
+    other.Rebuild(rejected);
+  }
+
+  // Inserts [first, last) in bulk. The new nodes are sorted (sorted input
+  // is only checked) and linked by LinkSorted. Equal keys keep their input
+  // order; without duplicate the first one wins.
+  template <typename InputIt>
+  void InsertRange(InputIt first, InputIt last, bool duplicate) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    std::vector<Node *> nodes;
+    std::vector<Node *> rejected;
+    try {
+      if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+        nodes.reserve(static_cast<size_type>(std::distance(first, last)));
       }
-    } else if (value > node->data || duplicate) {
-      if (node->right == nullptr) {
-        node->right = new Node(value);
-        node->right->parent = node;
-      } else {
-        Insert(node->right, value);
+      for (; first != last; ++first) {
+        // The slot comes first, so a built node is never held only here.
+        nodes.push_back(nullptr);
+        nodes.back() = pool_.New(*first);
+      }
+      if (!std::is_sorted(nodes.begin(), nodes.end(), NodeLess())) {
+        std::stable_sort(nodes.begin(), nodes.end(), NodeLess());
       }
+      LinkSorted(nodes, duplicate, rejected);
+    } catch (...) {
+      // A compare can throw after some nodes were linked; those stay.
+      for (Node *node : nodes) {
+        if (node != nullptr && node->parent == nullptr) pool_.Delete(node);
+      }
+      throw;
     }
+    for (Node *node : rejected) pool_.Delete(node);
   }
 
-  std::pair<iterator, bool> InsertOrAssign(const T &obj) {
-    std::pair<iterator, bool> result;
-    iterator null;
-    if (FindNumByIter(obj) == null) {
-      Insert(obj);
-      iterator node = FindNumByIter(obj);
-      result.first = node;
-      result.second = true;
-    } else {
-      iterator node = FindNumByIter(obj);
-      node.getCurrent()->data.second = obj.second;
-      result.first = node;
-      result.second = false;
+  // Builds a node from every argument, sorts them and links them like
+  // InsertRange, then reports in argument order the node each one became,
+  // or the equal one that kept it out, and whether it went in. A node the
+  // tree took has a parent; a rejected one was never linked.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> InsertMany(bool duplicate,
+                                                    Args &&...args) {
+    std::vector<Node *> nodes;
+    nodes.reserve(sizeof...(args));
+    std::vector<Node *> rejected;
+    try {
+      (nodes.push_back(pool_.New(std::forward<Args>(args))), ...);
+      std::vector<Node *> sorted(nodes);
+      std::stable_sort(sorted.begin(), sorted.end(), NodeLess());
+      LinkSorted(sorted, duplicate, rejected);
+    } catch (...) {
+      for (Node *node : nodes) {
+        if (node->parent == nullptr) pool_.Delete(node);
+      }
+      throw;
+    }
+    std::vector<std::pair<iterator, bool>> result;
+    result.reserve(nodes.size());
+    for (Node *node : nodes) {
+      if (node->parent != nullptr) {
+        result.emplace_back(iterator(node), true);
+      } else {
+        result.emplace_back(FindNum(KeyOfValue::KeyOf(node->data)), false);
+      }
     }
+    for (Node *node : rejected) pool_.Delete(node);
     return result;
   }
 
-  std::pair<iterator, bool> InsertBool(const value_type &value,
-                                       bool duplicate = false) {
-    std::pair<iterator, bool> result;
-    size_type begin_size = size();
-    Insert(value, duplicate);
-    if (size() == begin_size) {
-      iterator node = FindNumByIter(value);
-      result.first = node;
-      result.second = false;
-    } else {
-      iterator node = FindNumByIter(value);
-      result.first = node;
-      result.second = true;
+  enum class SetOp { kUnion, kIntersection, kDifference };
+
+  // Replaces the contents of this tree with a op b, computed by one
+  // in-order merge of both trees in O(n + m). Equal keys follow the
+  // std::set_* rules, so multisets get max, min and subtracted counts.
+  // With threads > 1 large inputs are cut into key ranges at equal-run
+  // boundaries and each range is merged by its own std::async task; the
+  // nodes are then created here and linked in one balanced build. Neither
+  // a nor b may be this tree.
+  void SetAlgebra(const BinaryTree &a, const BinaryTree &b, SetOp op,
+                  size_type threads = 1) {
+    clear();
+    std::vector<Node *> left = a.Flatten();
+    std::vector<Node *> right = b.Flatten();
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0 || left.size() + right.size() < kParallelCutoff) {
+      threads = 1;
     }
-    return result;
+    if (threads > left.size()) threads = left.empty() ? 1 : left.size();
+    std::vector<std::vector<Node *>> parts(threads);
+    std::vector<std::future<void>> tasks;
+    size_type a_begin = 0, b_begin = 0;
+    for (size_type part = 0; part != threads; ++part) {
+      size_type a_end = left.size(), b_end = right.size();
+      if (part + 1 != threads) {
+        Node *split = left[left.size() / threads * (part + 1)];
+        a_end = std::lower_bound(left.begin(), left.end(), split,
+                                 NodeLess()) -
+                left.begin();
+        b_end = std::lower_bound(right.begin(), right.end(), split,
+                                 NodeLess()) -
+                right.begin();
+      }
+      auto run = [&, part, op, a_begin, a_end, b_begin, b_end] {
+        MergeRuns(left.data() + a_begin, left.data() + a_end,
+                  right.data() + b_begin, right.data() + b_end, op,
+                  parts[part]);
+      };
+      if (part + 1 == threads) {
+        run();
+      } else {
+        tasks.push_back(std::async(std::launch::async, run));
+      }
+      a_begin = a_end;
+      b_begin = b_end;
+    }
+    for (auto &task : tasks) task.get();
+    std::vector<Node *> nodes;
+    try {
+      for (const auto &result : parts) {
+        for (Node *node : result) nodes.push_back(pool_.New(node->data));
+      }
+    } catch (...) {
+      for (Node *node : nodes) pool_.Delete(node);
+      throw;
+    }
+    Rebuild(nodes);
   }
 
-  void erase(iterator pos) {
-    if (pos.getCurrent() == nullptr || size() == 0)
-      throw std::invalid_argument("wrong argument");
-    root = delete_node(root, *pos);
-  }
-
-  Node *delete_node(Node *node, value_type value) {
-    Node *tmp = nullptr;
-    if (node != nullptr) {
-      if (value < node->data)
-        node->left = delete_node(node->left, value);
-      else if (value > node->data)
-        node->right = delete_node(node->right, value);
-      else if (node->left != nullptr && node->right != nullptr) {
-        tmp = node;
-        node = minimum(node->right);
-        node->left = tmp->left;
-        node->right = tmp->right;
-        node->parent = tmp->parent;
-        // node->data = minimum(node->right)->data;
-        // node->right = delete_node(node->right, node->data);
-      } else if (node->left != nullptr) {
-        tmp = node;
-        node = node->left;
-        node->parent = tmp->parent;
-      } else if (node->right != nullptr) {
-        tmp = node;
+  // Lookups accept any K comparable with Key, so with a transparent
+  // Compare a map<std::string, ...> can be searched with a std::string_view
+  // without building a string.
+  template <typename K>
+  iterator FindNum(const K &key) const {
+    Node *node = FindNumByKey(header_.parent, key);
+    return node != nullptr ? iterator(node) : end();
+  }
+
+  // First node not less than key.
+  template <typename K>
+  iterator LowerBound(const K &key) const {
+    NodeBase *node = header_.parent;
+    NodeBase *result = Header();
+    while (node != nullptr) {
+      if (Less(KeyOf(node), key)) {
         node = node->right;
-        node->parent = tmp->parent;
       } else {
-        tmp = node;
-        node = nullptr;
-      }
-      if (tmp != nullptr) {
-        delete (tmp);
+        result = node;
+        node = node->left;
       }
     }
-    return node;
+    return iterator(result);
   }
 
-  Node *minimum(Node *node) {
-    Node *tmp = node;
-    if (tmp != nullptr) {
-      while (tmp->left) {
-        tmp = tmp->left;
+  // First node greater than key.
+  template <typename K>
+  iterator UpperBound(const K &key) const {
+    NodeBase *node = header_.parent;
+    NodeBase *result = Header();
+    while (node != nullptr) {
+      if (Less(key, KeyOf(node))) {
+        result = node;
+        node = node->left;
+      } else {
+        node = node->right;
       }
     }
-    return tmp;
+    return iterator(result);
   }
 
-  void swap(BinaryTree &other) { std::swap(root, other.root); }
-  void merge(BinaryTree &other) {
-    for (iterator it = other.begin(); it != other.end(); ++it) {
-      Insert(*it);
-    }
+  template <typename K>
+  std::pair<iterator, iterator> EqualRange(const K &key) const {
+    return {LowerBound(key), UpperBound(key)};
   }
 
-  iterator FindNum(const Key &key) { return iterator(FindNumByKey(root, key)); }
+  template <typename K>
+  size_type Count(const K &key) const {
+    size_type counter = 0;
+    auto range = EqualRange(key);
+    for (iterator it = range.first; it != range.second; ++it) {
+      ++counter;
+    }
+    return counter;
+  }
 
-  iterator FindNumByIter(value_type value, bool lower = false,
-                         bool upper = false) {
-    iterator node = begin();
-    if (!lower && !upper) {
-      return iterator(FindNumByValue(root, value));
-    } else if (lower) {
-      while (value > node.getCurrent()->data) {
-        node++;
+  // A scalar key is compared both ways at every level: the second compare
+  // is one instruction on a value already loaded, and stopping at the match
+  // saves the cache misses below it. GCC picks the next node with a cmov
+  // there, where a branch would mispredict half the time on random keys.
+  // Any other key, a string say, pays for each compare, so it gets the
+  // usual lower-bound descent with one compare per level and one equality
+  // check at the end, its two picks still selects.
+  template <typename K>
+  Node *FindNumByKey(NodeBase *node, const K &key) const {
+    if constexpr (std::is_scalar_v<Key>) {
+      while (node != nullptr) {
+        bool to_left = Less(key, KeyOf(node));
+        bool to_right = Less(KeyOf(node), key);
+        if (!(to_left | to_right)) return static_cast<Node *>(node);
+        node = to_left ? node->left : node->right;
       }
-    } else if (upper) {
-      while (node.getCurrent()->data <= value) {
-        node++;
+      return nullptr;
+    } else {
+      NodeBase *result = nullptr;
+      while (node != nullptr) {
+        bool to_right = Less(KeyOf(node), key);
+        // A table, as a second ternary turns the loop back into branches.
+        NodeBase *candidates[2] = {node, result};
+        result = candidates[to_right];
+        node = to_right ? node->right : node->left;
       }
+      if (result == nullptr || Less(key, KeyOf(result))) return nullptr;
+      return static_cast<Node *>(result);
     }
-    return node;
   }
 
-  Node *FindNumByKey(Node *node, Key value) {
-    if (Comparator::Equality(node->data, value) || node == nullptr) {
-      return node;
-    }
-    while (Comparator::NotEquality(node->data, value) && node != nullptr) {
-      if (Comparator::Less(node->data, value)) {
+  // Mirrors the tree under source node by node, walking both trees in
+  // step through parent links, so the stack depth stays constant.
+  void CopyTree(const NodeBase *source) {
+    NodeBase *node = pool_.New(static_cast<const Node *>(source)->data);
+    node->parent = &header_;
+    node->color = source->color;
+    header_.parent = node;
+    while (node != &header_) {
+      if (source->left != nullptr && node->left == nullptr) {
+        source = source->left;
+        node->left = pool_.New(static_cast<const Node *>(source)->data);
+        node->left->parent = node;
         node = node->left;
-      } else {
+      } else if (source->right != nullptr && node->right == nullptr) {
+        source = source->right;
+        node->right = pool_.New(static_cast<const Node *>(source)->data);
+        node->right->parent = node;
         node = node->right;
+      } else {
+        source = source->parent;
+        node = node->parent;
+        continue;
       }
-      if (node == nullptr) {
-        break;
+      node->color = source->color;
+    }
+    header_.left = RbTree::Minimum(header_.parent);
+    header_.right = RbTree::Maximum(header_.parent);
+  }
+
+  // Runs the destructors only; clear() releases the memory afterwards.
+  // Leaves are destroyed and cut off as the walk climbs back, so no stack
+  // is needed. Trivially destructible values skip the walk.
+  void ClearTree() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      NodeBase *node = header_.parent;
+      while (node != &header_) {
+        if (node->left != nullptr) {
+          node = node->left;
+        } else if (node->right != nullptr) {
+          node = node->right;
+        } else {
+          NodeBase *parent = node->parent;
+          (parent->left == node ? parent->left : parent->right) = nullptr;
+          pool_.Destroy(static_cast<Node *>(node));
+          node = parent;
+        }
       }
     }
-    return node;
   }
 
-  Node *FindNumByValue(Node *node, value_type value) {
-    if (Comparator::Equality(node->data, value) || node == nullptr) {
-      return node;
+ private:
+  template <typename V>
+  std::pair<iterator, bool> InsertValue(V &&value, bool duplicate) {
+    NodeBase *parent = nullptr;
+    bool to_left = false;
+    Node *found =
+        FindSlot(KeyOfValue::KeyOf(value), duplicate, parent, to_left);
+    if (found != nullptr) {
+      return {iterator(found), false};
     }
-    while (Comparator::NotEquality(node->data, value) && node != nullptr) {
-      if (value < node->data) {
+    Node *node = pool_.New(std::forward<V>(value));
+    LinkNode(node, parent, to_left);
+    return {iterator(node), true};
+  }
+
+  // Returns the node whose key equals key (never when duplicates are
+  // allowed, they go after their equals) or nullptr and the parent and side
+  // of the empty slot where key belongs. In an empty tree the parent is
+  // the header.
+  Node *FindSlot(const Key &key, bool duplicate, NodeBase *&parent,
+                 bool &to_left) const {
+    NodeBase *node = header_.parent;
+    parent = Header();
+    to_left = false;
+    while (node != nullptr) {
+      parent = node;
+      if (Less(key, KeyOf(node))) {
+        to_left = true;
         node = node->left;
-      } else {
+      } else if (duplicate || Less(KeyOf(node), key)) {
+        to_left = false;
         node = node->right;
-      }
-      if (node == nullptr) {
-        break;
+      } else {
+        return static_cast<Node *>(node);
       }
     }
-    return node;
+    return nullptr;
+  }
+
+  // Whether key belongs right before next, between it and the node before
+  // it; if so, parent and to_left are set to that slot without a descent.
+  // With duplicate a prev equal to key fits, and a next equal to key only
+  // with before_equal: a hint asks for that, while a batch goes after the
+  // equal keys already stored, as a single insert does.
+  bool FitsBefore(NodeBase *next, const Key &key, bool duplicate,
+                  bool before_equal, NodeBase *&parent,
+                  bool &to_left) const {
+    NodeBase *prev = next == header_.left ? nullptr : RbTree::Prev(next);
+    bool fits_next = next == Header() ||
+                     (duplicate && before_equal ? !Less(KeyOf(next), key)
+                                                : Less(key, KeyOf(next)));
+    bool fits_prev =
+        prev == nullptr ||
+        (duplicate ? !Less(key, KeyOf(prev)) : Less(KeyOf(prev), key));
+    if (!fits_next || !fits_prev) return false;
+    to_left = next != Header() && next->left == nullptr;
+    parent = to_left ? next : (prev != nullptr ? prev : Header());
+    return true;
+  }
+
+  void LinkNode(NodeBase *node, NodeBase *parent, bool to_left) {
+    RbTree::Link(node, parent, to_left, header_);
+    ++size_;
   }
 
-  void CopyTree(Node *node, Node *node_copy) {
-    if (node_copy->left != nullptr) {
-      node->left = new Node(node_copy->left->data);
-      node->left->parent = node;
-      CopyTree(node->left, node_copy->left);
+  NodeBase *Header() const { return const_cast<NodeBase *>(&header_); }
+
+  void ResetHeader() noexcept {
+    header_.parent = nullptr;
+    header_.left = header_.right = &header_;
+  }
+
+  // Points the root back at this header after the links moved here.
+  void AdoptNodes() noexcept {
+    if (header_.parent != nullptr) {
+      header_.parent->parent = &header_;
+    } else {
+      ResetHeader();
     }
-    if (node_copy->right != nullptr) {
-      node->right = new Node(node_copy->right->data);
-      node->right->parent = node;
-      CopyTree(node->right, node_copy->right);
+  }
+
+  static const Key &KeyOf(const NodeBase *node) {
+    return KeyOfValue::KeyOf(static_cast<const Node *>(node)->data);
+  }
+
+  template <typename A, typename B>
+  bool Less(const A &a, const B &b) const {
+    return Holder::Comp()(a, b);
+  }
+
+  bool KeyLess(const Node *a, const Node *b) const {
+    return Less(KeyOfValue::KeyOf(a->data), KeyOfValue::KeyOf(b->data));
+  }
+
+  // KeyLess as a function object for the std algorithms.
+  auto NodeLess() const {
+    return [this](const Node *a, const Node *b) { return KeyLess(a, b); };
+  }
+
+  static constexpr size_type kParallelCutoff = size_type(1) << 16;
+
+  // The nodes in key order; the tree itself is left untouched.
+  std::vector<Node *> Flatten() const {
+    std::vector<Node *> nodes;
+    nodes.reserve(size_);
+    for (iterator it = begin(); it != end(); ++it) {
+      nodes.push_back(static_cast<Node *>(it.getCurrent()));
+    }
+    return nodes;
+  }
+
+  // Makes the sorted nodes, and nothing else, this tree.
+  void Rebuild(std::vector<Node *> &nodes) {
+    size_ = nodes.size();
+    header_.parent = BuildBalanced(nodes.data(), nodes.size(), &header_, 0,
+                                   FloorLog2(nodes.size()));
+    if (nodes.empty()) {
+      ResetHeader();
+    } else {
+      header_.parent->color = Color::kBlack;
+      header_.left = nodes.front();
+      header_.right = nodes.back();
     }
+    nodes.clear();
   }
 
-  void ClearTree(Node *node) {
-    if (node->left != nullptr) {
-      ClearTree(node->left);
-      delete node->left;
-      node->left = nullptr;
+  // Links sorted nodes owned by this pool into the tree. Nodes whose key
+  // is already present (without duplicate) go to rejected in order. A
+  // batch too small to pay for a rebuild is linked node by node; otherwise
+  // both sequences are merged and the tree is rebuilt balanced in
+  // O(n + m). Either way equal keys keep the existing nodes first. If a
+  // compare throws, the tree is valid and the nodes not linked yet are
+  // those with no parent.
+  void LinkSorted(const std::vector<Node *> &nodes, bool duplicate,
+                  std::vector<Node *> &rejected) {
+    rejected.reserve(nodes.size());
+    if (nodes.size() * FloorLog2(size_ + nodes.size()) < 4 * size_) {
+      // Each node is tried right before the successor of the previous one
+      // first, so a run of keys landing in one gap, or past the end, links
+      // without descents. A node linked there has that same successor.
+      NodeBase *hint = Header();
+      for (Node *node : nodes) {
+        const Key &key = KeyOfValue::KeyOf(node->data);
+        NodeBase *parent = nullptr;
+        bool to_left = false;
+        if (FitsBefore(hint, key, duplicate, false, parent, to_left)) {
+          LinkNode(node, parent, to_left);
+        } else if (Node *found = FindSlot(key, duplicate, parent, to_left)) {
+          rejected.push_back(node);
+          hint = RbTree::Next(found);
+        } else {
+          LinkNode(node, parent, to_left);
+          hint = RbTree::Next(node);
+        }
+      }
+      return;
     }
-    if (node->right != nullptr) {
-      ClearTree(node->right);
-      delete node->right;
-      node->right = nullptr;
+    std::vector<Node *> all;
+    all.reserve(size_ + nodes.size());
+    auto take_new = [&](Node *node) {
+      if (!duplicate && !all.empty() && !KeyLess(all.back(), node)) {
+        rejected.push_back(node);
+      } else {
+        all.push_back(node);
+      }
+    };
+    auto next = nodes.begin();
+    for (iterator it = begin(); it != end(); ++it) {
+      Node *node = static_cast<Node *>(it.getCurrent());
+      while (next != nodes.end() && KeyLess(*next, node)) take_new(*next++);
+      all.push_back(node);
     }
-    if (root->left == nullptr && root->right == nullptr) {
-      delete root;
-      root = nullptr;
+    while (next != nodes.end()) take_new(*next++);
+    Rebuild(all);
+  }
+
+  // std::set_union and friends over two sorted node runs.
+  void MergeRuns(Node *const *a, Node *const *a_end, Node *const *b,
+                 Node *const *b_end, SetOp op,
+                 std::vector<Node *> &out) const {
+    while (a != a_end && b != b_end) {
+      if (KeyLess(*a, *b)) {
+        if (op != SetOp::kIntersection) out.push_back(*a);
+        ++a;
+      } else if (KeyLess(*b, *a)) {
+        if (op == SetOp::kUnion) out.push_back(*b);
+        ++b;
+      } else {
+        if (op != SetOp::kDifference) out.push_back(*a);
+        ++a;
+        ++b;
+      }
     }
+    if (op != SetOp::kIntersection) out.insert(out.end(), a, a_end);
+    if (op == SetOp::kUnion) out.insert(out.end(), b, b_end);
   }
 
- private:
-  Node *root{nullptr};
+  static size_type FloorLog2(size_type n) {
+    size_type log = 0;
+    while (n > 1) {
+      n >>= 1;
+      ++log;
+    }
+    return log;
+  }
+
+  // Links the in-order nodes[0, n) into a tree whose leaves sit on the last
+  // two levels. Every node above red_depth is black and the ones on it are
+  // red, which gives all paths the same black height.
+  static Node *BuildBalanced(Node **nodes, size_type n, NodeBase *parent,
+                             size_type depth, size_type red_depth) {
+    if (n == 0) return nullptr;
+    size_type mid = n / 2;
+    Node *node = nodes[mid];
+    node->parent = parent;
+    node->color = depth == red_depth ? Color::kRed : Color::kBlack;
+    node->left = BuildBalanced(nodes, mid, node, depth + 1, red_depth);
+    node->right = BuildBalanced(nodes + mid + 1, n - mid - 1, node, depth + 1,
+                                red_depth);
+    return node;
+  }
+
+  using node_allocator = typename NodePool<Node, Allocator>::allocator_type;
+
+  NodeBase header_{&header_, &header_, nullptr, Color::kRed};
+  size_type size_{0};
+  NodePool<Node, Allocator> pool_;
 };
 }  // namespace s21
 
@@ -0,0 +1,163 @@
+#ifndef S21_UNORDERED_MAP_H
+#define S21_UNORDERED_MAP_H
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../hash_table/s21_hash_table.h"
+
+namespace s21 {
+// Hash map over an open-addressing table. Unlike std::unordered_map, an
+// insert that grows the table invalidates iterators and references.
+// Lookups take any key type when Hash and KeyEqual are both transparent.
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  struct KeyOfValue {
+    static const Key &KeyOf(const value_type &value) { return value.first; }
+  };
+
+ private:
+  using Table =
+      HashTable<Key, value_type, KeyOfValue, Hash, KeyEqual, Allocator>;
+  template <typename K>
+  using Transparent = typename Table::template EnableIfTransparent<K>;
+
+ public:
+  using iterator = typename Table::iterator;
+  using const_iterator = typename Table::const_iterator;
+  unordered_map() : table_() {}
+  explicit unordered_map(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual(),
+                         const Allocator &alloc = Allocator())
+      : table_(bucket_count, hash, equal, alloc) {}
+  unordered_map(std::initializer_list<value_type> const &items)
+      : unordered_map(items.begin(), items.end()) {}
+  template <typename InputIt>
+  unordered_map(InputIt first, InputIt last) {
+    table_.InsertRange(first, last);
+  }
+  unordered_map(const unordered_map &m) : table_(m.table_) {}
+  unordered_map(unordered_map &&m) : table_(std::move(m.table_)) {}
+  ~unordered_map() {}
+  unordered_map &operator=(unordered_map &&m) {
+    table_ = std::move(m.table_);
+    return *this;
+  }
+  // element access
+  T &at(const Key &key) {
+    iterator node = table_.Find(key);
+    if (node == end()) {
+      throw std::out_of_range("key not found");
+    }
+    return node->second;
+  }
+  const T &at(const Key &key) const {
+    iterator node = table_.Find(key);
+    if (node == end()) {
+      throw std::out_of_range("key not found");
+    }
+    return node->second;
+  }
+  T &operator[](const Key &key) {
+    return table_.TryEmplace(key).first->second;
+  }
+  T &operator[](Key &&key) {
+    return table_.TryEmplace(std::move(key)).first->second;
+  }
+  // iterators
+  iterator begin() const noexcept { return table_.begin(); }
+  iterator end() const noexcept { return table_.end(); }
+  // capacity
+  bool empty() const noexcept { return table_.empty(); }
+  size_type size() const noexcept { return table_.size(); }
+  size_type max_size() const noexcept { return table_.max_size(); }
+  allocator_type get_allocator() const { return table_.get_allocator(); }
+  hasher hash_function() const { return table_.hash_function(); }
+  key_equal key_eq() const { return table_.key_eq(); }
+  // modifiers
+  void clear() noexcept { table_.clear(); }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return table_.InsertValue(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return table_.InsertValue(std::move(value));
+  }
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return table_.TryEmplace(key, obj);
+  }
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    table_.InsertRange(first, last);
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    return table_.InsertOrAssign(key, std::forward<M>(obj));
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&obj) {
+    return table_.InsertOrAssign(std::move(key), std::forward<M>(obj));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return table_.TryEmplace(key, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return table_.TryEmplace(std::move(key), std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return table_.Emplace(std::forward<Args>(args)...);
+  }
+  void erase(iterator pos) { table_.erase(pos); }
+  void swap(unordered_map &other) { table_.swap(other.table_); }
+  void merge(unordered_map &other) { table_.merge(other.table_); }
+  // lookup
+  iterator find(const Key &key) const { return table_.Find(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator find(const K &key) const {
+    return table_.Find(key);
+  }
+  bool contains(const Key &key) const { return table_.Find(key) != end(); }
+  template <typename K, typename = Transparent<K>>
+  bool contains(const K &key) const {
+    return table_.Find(key) != end();
+  }
+  size_type count(const Key &key) const { return table_.Count(key); }
+  template <typename K, typename = Transparent<K>>
+  size_type count(const K &key) const {
+    return table_.Count(key);
+  }
+  // hash policy
+  size_type bucket_count() const noexcept { return table_.bucket_count(); }
+  float load_factor() const noexcept { return table_.load_factor(); }
+  float max_load_factor() const noexcept { return table_.max_load_factor(); }
+  void rehash(size_type count) { table_.rehash(count); }
+  void reserve(size_type count) { table_.reserve(count); }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return table_.InsertMany(std::forward<Args>(args)...);
+  }
+
+ private:
+  Table table_;
+};
+}  // namespace s21
+
+#endif  // S21_UNORDERED_MAP_H
@@ -0,0 +1,114 @@
+#ifndef S21_UNORDERED_SET_
+#define S21_UNORDERED_SET_
+
+#include <functional>
+#include <vector>
+
+#include "../hash_table/s21_hash_table.h"
+
+namespace s21 {
+// Hash set over an open-addressing table. Unlike std::unordered_set, an
+// insert that grows the table invalidates iterators and references.
+// Lookups take any key type when Hash and KeyEqual are both transparent.
+template <class Key, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<Key>>
+class unordered_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  struct KeyOfValue {
+    static const Key &KeyOf(const value_type &value) { return value; }
+  };
+
+ private:
+  using Table = HashTable<Key, Key, KeyOfValue, Hash, KeyEqual, Allocator>;
+  template <typename K>
+  using Transparent = typename Table::template EnableIfTransparent<K>;
+
+ public:
+  using iterator = typename Table::iterator;
+  using const_iterator = typename Table::const_iterator;
+  unordered_set() : table_() {}
+  explicit unordered_set(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual(),
+                         const Allocator &alloc = Allocator())
+      : table_(bucket_count, hash, equal, alloc) {}
+  unordered_set(std::initializer_list<value_type> const &items)
+      : unordered_set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  unordered_set(InputIt first, InputIt last) {
+    table_.InsertRange(first, last);
+  }
+  unordered_set(const unordered_set &s) : table_(s.table_) {}
+  unordered_set(unordered_set &&s) : table_(std::move(s.table_)) {}
+  ~unordered_set() {}
+  unordered_set &operator=(unordered_set &&s) {
+    table_ = std::move(s.table_);
+    return *this;
+  }
+  iterator begin() const noexcept { return table_.begin(); }
+  iterator end() const noexcept { return table_.end(); }
+  bool empty() const noexcept { return table_.empty(); }
+  size_type size() const noexcept { return table_.size(); }
+  size_type max_size() const noexcept { return table_.max_size(); }
+  allocator_type get_allocator() const { return table_.get_allocator(); }
+  hasher hash_function() const { return table_.hash_function(); }
+  key_equal key_eq() const { return table_.key_eq(); }
+  void clear() noexcept { table_.clear(); }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return table_.InsertValue(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return table_.InsertValue(std::move(value));
+  }
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    table_.InsertRange(first, last);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return table_.Emplace(std::forward<Args>(args)...);
+  }
+  void erase(iterator pos) { table_.erase(pos); }
+  void swap(unordered_set &other) { table_.swap(other.table_); }
+  void merge(unordered_set &other) { table_.merge(other.table_); }
+  iterator find(const Key &key) const { return table_.Find(key); }
+  template <typename K, typename = Transparent<K>>
+  iterator find(const K &key) const {
+    return table_.Find(key);
+  }
+  bool contains(const Key &key) const { return table_.Find(key) != end(); }
+  template <typename K, typename = Transparent<K>>
+  bool contains(const K &key) const {
+    return table_.Find(key) != end();
+  }
+  size_type count(const Key &key) const { return table_.Count(key); }
+  template <typename K, typename = Transparent<K>>
+  size_type count(const K &key) const {
+    return table_.Count(key);
+  }
+  // hash policy
+  size_type bucket_count() const noexcept { return table_.bucket_count(); }
+  float load_factor() const noexcept { return table_.load_factor(); }
+  float max_load_factor() const noexcept { return table_.max_load_factor(); }
+  void rehash(size_type count) { table_.rehash(count); }
+  void reserve(size_type count) { table_.reserve(count); }
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return table_.InsertMany(std::forward<Args>(args)...);
+  }
+
+ private:
+  Table table_;
+};
+}  // namespace s21
+
+#endif  // S21_UNORDERED_SET_
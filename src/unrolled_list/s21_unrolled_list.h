@@ -0,0 +1,520 @@
+#ifndef S21_UNROLLED_LIST_H
+#define S21_UNROLLED_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../allocator/s21_inline_storage.h"
+
+namespace s21 {
+
+// Doubly linked list of chunks that hold up to kSlots values each, packed
+// at the front. Walking it follows one pointer per chunk instead of one
+// per value and reads the values of a chunk contiguously, so traversal,
+// sort and unique run at close to vector speed.
+//
+// Insert and erase shift values within their chunk, and an insert into a
+// full chunk moves half of it to a new one; either way they invalidate
+// iterators at and after pos in that chunk. Iterators into other chunks
+// stay valid. Unlike list there is no splice, as values cannot be
+// relinked without moving them.
+template <typename T, typename Allocator = std::allocator<T>>
+class unrolled_list {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  // Four cache lines, as for BTree nodes: a chunk of ints holds 58 values.
+  static constexpr size_type kChunkBytes = 256;
+
+ private:
+  struct ChunkBase {
+    ChunkBase *prev;
+    ChunkBase *next;
+    size_type count;
+  };
+
+ public:
+  static constexpr size_type kSlots = std::max<size_type>(
+      4, (kChunkBytes - sizeof(ChunkBase)) / sizeof(value_type));
+
+ private:
+  struct Chunk : ChunkBase {
+    InlineStorage<value_type, kSlots> slots;
+    value_type *values() { return slots.get(); }
+  };
+
+ public:
+  // A chunk and a slot in it; end() is slot 0 of the header. iterator
+  // converts to const_iterator, which only hands out const references.
+  template <bool kConst>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<kConst, const T *, T *>;
+    using reference = std::conditional_t<kConst, const T &, T &>;
+
+    Iterator() = default;
+    template <bool kOther, typename = std::enable_if_t<kConst && !kOther>>
+    Iterator(const Iterator<kOther> &other)
+        : chunk_(other.chunk_), index_(other.index_) {}
+    reference operator*() const {
+      return static_cast<Chunk *>(chunk_)->values()[index_];
+    }
+    pointer operator->() const { return &**this; }
+    Iterator &operator++() {
+      if (++index_ == chunk_->count) {
+        chunk_ = chunk_->next;
+        index_ = 0;
+      }
+      return *this;
+    }
+    Iterator &operator--() {
+      if (index_ == 0) {
+        chunk_ = chunk_->prev;
+        index_ = chunk_->count;
+      }
+      --index_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator it(*this);
+      ++(*this);
+      return it;
+    }
+    Iterator operator--(int) {
+      Iterator it(*this);
+      --(*this);
+      return it;
+    }
+    template <bool kOther>
+    bool operator==(const Iterator<kOther> &other) const {
+      return chunk_ == other.chunk_ && index_ == other.index_;
+    }
+    template <bool kOther>
+    bool operator!=(const Iterator<kOther> &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class unrolled_list;
+    template <bool>
+    friend class Iterator;
+    Iterator(ChunkBase *chunk, size_type index)
+        : chunk_(chunk), index_(index) {}
+
+    ChunkBase *chunk_{nullptr};
+    size_type index_{0};
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  unrolled_list() = default;
+  explicit unrolled_list(const Allocator &alloc) : alloc_(alloc) {}
+  explicit unrolled_list(size_type n) {
+    if (n >= max_size()) {
+      throw std::out_of_range("Limit of the container is exceeded");
+    }
+    for (size_type i = 0; i < n; ++i) emplace_back();
+  }
+  unrolled_list(std::initializer_list<value_type> const &items) {
+    for (const auto &item : items) push_back(item);
+  }
+  unrolled_list(const unrolled_list &other)
+      : alloc_(std::allocator_traits<Allocator>::
+                   select_on_container_copy_construction(other.alloc_)) {
+    try {
+      for (const auto &value : other) push_back(value);
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+  unrolled_list(unrolled_list &&other) noexcept : alloc_(other.alloc_) {
+    swap(other);
+  }
+  ~unrolled_list() { clear(); }
+  unrolled_list &operator=(unrolled_list &&other) {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // element access
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *--end(); }
+  const_reference back() const { return *--end(); }
+
+  // iterators
+  iterator begin() noexcept { return iterator(header_.next, 0); }
+  const_iterator begin() const noexcept {
+    return const_iterator(header_.next, 0);
+  }
+  iterator end() noexcept { return iterator(&header_, 0); }
+  const_iterator end() const noexcept {
+    return const_iterator(const_cast<ChunkBase *>(&header_), 0);
+  }
+
+  // capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type) / 2;
+  }
+  allocator_type get_allocator() const { return alloc_; }
+
+  // modifiers
+  void clear() noexcept {
+    for (ChunkBase *chunk = header_.next; chunk != &header_;) {
+      ChunkBase *next = chunk->next;
+      DestroyRange(static_cast<Chunk *>(chunk), 0, chunk->count);
+      FreeChunk(static_cast<Chunk *>(chunk));
+      chunk = next;
+    }
+    header_.prev = header_.next = &header_;
+    size_ = 0;
+  }
+
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+  // The value is built before anything moves, so args may refer to an
+  // element of this list.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    Chunk *chunk;
+    size_type index;
+    ChunkBase *prev = pos.chunk_->prev;
+    if (pos.index_ == 0 && prev != &header_ && prev->count < kSlots) {
+      chunk = static_cast<Chunk *>(prev);
+      index = prev->count;
+    } else if (pos.chunk_ == &header_) {
+      chunk = NewChunkAfter(header_.prev);
+      index = 0;
+    } else {
+      chunk = static_cast<Chunk *>(pos.chunk_);
+      index = pos.index_;
+      if (chunk->count == kSlots) std::tie(chunk, index) = Split(chunk, index);
+    }
+    return PlaceAt(chunk, index, std::move(value));
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    ChunkBase *last = header_.prev;
+    if (last == &header_ || last->count == kSlots) {
+      value_type value(std::forward<Args>(args)...);
+      Chunk *chunk = NewChunkAfter(last);
+      return *PlaceAt(chunk, 0, std::move(value));
+    }
+    Chunk *chunk = static_cast<Chunk *>(last);
+    value_type *slot = chunk->values() + chunk->count;
+    Construct(slot, std::forward<Args>(args)...);
+    ++chunk->count;
+    ++size_;
+    return *slot;
+  }
+  void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("list is empty");
+    }
+    Chunk *chunk = static_cast<Chunk *>(header_.prev);
+    DestroyRange(chunk, chunk->count - 1, chunk->count);
+    --size_;
+    if (--chunk->count == 0) UnlinkAndFree(chunk);
+  }
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+  }
+  void pop_front() {
+    if (empty()) {
+      throw std::out_of_range("list is empty");
+    }
+    erase(begin());
+  }
+
+  // Returns the iterator to the value after pos. A chunk left less than a
+  // quarter full takes in its successor when they fit together.
+  iterator erase(const_iterator pos) {
+    if (pos.chunk_ == nullptr || pos.chunk_ == &header_) {
+      throw std::invalid_argument("Invalid argument");
+    }
+    Chunk *chunk = static_cast<Chunk *>(pos.chunk_);
+    size_type index = pos.index_;
+    value_type *values = chunk->values();
+    DestroyRange(chunk, index, index + 1);
+    Relocate(values + index, values + index + 1, chunk->count - index - 1);
+    --chunk->count;
+    --size_;
+    ChunkBase *next = chunk->next;
+    if (chunk->count == 0) {
+      UnlinkAndFree(chunk);
+      return iterator(next, 0);
+    }
+    if (chunk->count < kSlots / 4 && next != &header_ &&
+        chunk->count + next->count <= kSlots) {
+      Chunk *absorbed = static_cast<Chunk *>(next);
+      Relocate(values + chunk->count, absorbed->values(), absorbed->count);
+      chunk->count += absorbed->count;
+      absorbed->count = 0;
+      UnlinkAndFree(absorbed);
+    }
+    return index < chunk->count ? iterator(chunk, index)
+                                : iterator(chunk->next, 0);
+  }
+
+  void swap(unrolled_list &other) noexcept {
+    std::swap(header_, other.header_);
+    std::swap(size_, other.size_);
+    std::swap(alloc_, other.alloc_);
+    AdoptChunks(other.header_);
+    other.AdoptChunks(header_);
+  }
+
+  // Merges the sorted other into this sorted list, equal values of this
+  // list first. Values are moved into fresh, full chunks, all allocated
+  // before the first value moves. If comp throws, what was not merged yet
+  // follows in order and nothing is lost; if moving a value throws, only
+  // the basic guarantee holds.
+  void merge(unrolled_list &other) { merge(other, std::less<value_type>()); }
+  template <typename Compare>
+  void merge(unrolled_list &other, Compare comp) {
+    if (this == &other || other.empty()) return;
+    unrolled_list merged(alloc_);
+    size_type total = size_ + other.size_;
+    for (size_type n = 0; n < total; n += kSlots) {
+      merged.NewChunkAfter(merged.header_.prev);
+    }
+    Chunk *out = static_cast<Chunk *>(merged.header_.next);
+    // Advances from only once its value is in place.
+    auto take = [&](iterator &from) {
+      if (out->count == kSlots) out = static_cast<Chunk *>(out->next);
+      merged.Construct(out->values() + out->count, std::move(*from));
+      ++out->count;
+      ++merged.size_;
+      ++from;
+    };
+    auto finish = [&](iterator &a, iterator &b) {
+      while (a != end()) take(a);
+      while (b != other.end()) take(b);
+      other.clear();
+      swap(merged);
+    };
+    iterator a = begin();
+    iterator b = other.begin();
+    try {
+      while (a != end() && b != other.end()) take(comp(*b, *a) ? b : a);
+    } catch (...) {
+      finish(a, b);
+      throw;
+    }
+    finish(a, b);
+  }
+
+  void reverse() noexcept {
+    ChunkBase *chunk = &header_;
+    do {
+      std::swap(chunk->prev, chunk->next);
+      if (chunk != &header_) {
+        value_type *values = static_cast<Chunk *>(chunk)->values();
+        std::reverse(values, values + chunk->count);
+      }
+      chunk = chunk->next;
+    } while (chunk != &header_);
+  }
+
+  // Keeps the first of every run of equal values, compacting the rest of
+  // the list forward in one pass.
+  void unique() {
+    if (size_ < 2) return;
+    iterator write = begin();
+    for (iterator read = std::next(write); read != end(); ++read) {
+      if (!(*write == *read)) {
+        ++write;
+        if (write != read) *write = std::move(*read);
+      }
+    }
+    Truncate(++write);
+  }
+
+  // Stable. The values are sorted in one contiguous buffer and moved back
+  // to the slots they came from, so the chunks do not change.
+  void sort() { sort(std::less<value_type>()); }
+  template <typename Compare>
+  void sort(Compare comp) {
+    if (size_ < 2) return;
+    std::vector<value_type> buffer;
+    buffer.reserve(size_);
+    for (auto &value : *this) buffer.push_back(std::move(value));
+    try {
+      std::stable_sort(buffer.begin(), buffer.end(), comp);
+    } catch (...) {
+      MoveBack(buffer);
+      throw;
+    }
+    MoveBack(buffer);
+  }
+
+ private:
+  using chunk_traits = typename std::allocator_traits<
+      Allocator>::template rebind_traits<Chunk>;
+  using value_traits = std::allocator_traits<Allocator>;
+
+  // Moves n values from from to the raw slots at to and leaves from raw.
+  // The ranges may overlap either way.
+  static void Relocate(value_type *to, value_type *from, size_type n) {
+    if constexpr (std::is_trivially_copyable_v<value_type>) {
+      if (n != 0) {
+        std::memmove(static_cast<void *>(to), from, n * sizeof(value_type));
+      }
+    } else if (to < from) {
+      for (size_type i = 0; i != n; ++i) {
+        ::new (static_cast<void *>(to + i)) value_type(std::move(from[i]));
+        from[i].~value_type();
+      }
+    } else {
+      for (size_type i = n; i-- != 0;) {
+        ::new (static_cast<void *>(to + i)) value_type(std::move(from[i]));
+        from[i].~value_type();
+      }
+    }
+  }
+
+  template <typename... Args>
+  void Construct(value_type *slot, Args &&...args) {
+    Allocator alloc(alloc_);
+    value_traits::construct(alloc, slot, std::forward<Args>(args)...);
+  }
+
+  void DestroyRange(Chunk *chunk, size_type from, size_type to) noexcept {
+    Allocator alloc(alloc_);
+    for (size_type i = from; i != to; ++i) {
+      value_traits::destroy(alloc, chunk->values() + i);
+    }
+  }
+
+  Chunk *NewChunkAfter(ChunkBase *prev) {
+    typename chunk_traits::allocator_type alloc(alloc_);
+    Chunk *chunk = chunk_traits::allocate(alloc, 1);
+    ::new (static_cast<void *>(chunk)) Chunk();
+    chunk->prev = prev;
+    chunk->next = prev->next;
+    chunk->count = 0;
+    prev->next->prev = chunk;
+    prev->next = chunk;
+    return chunk;
+  }
+
+  void FreeChunk(Chunk *chunk) noexcept {
+    typename chunk_traits::allocator_type alloc(alloc_);
+    chunk_traits::deallocate(alloc, chunk, 1);
+  }
+
+  // The chunk must hold no values.
+  void UnlinkAndFree(Chunk *chunk) noexcept {
+    chunk->prev->next = chunk->next;
+    chunk->next->prev = chunk->prev;
+    FreeChunk(chunk);
+  }
+
+  // Moves the upper half of a full chunk to a new one after it and
+  // returns where the slot for index ended up.
+  std::pair<Chunk *, size_type> Split(Chunk *chunk, size_type index) {
+    Chunk *upper = NewChunkAfter(chunk);
+    size_type half = kSlots / 2;
+    Relocate(upper->values(), chunk->values() + half, kSlots - half);
+    upper->count = kSlots - half;
+    chunk->count = half;
+    if (index > half) return {upper, index - half};
+    return {chunk, index};
+  }
+
+  // Opens a slot at index of a chunk with room and moves value into it. A
+  // throwing move closes the gap again, and drops the chunk if it was new.
+  iterator PlaceAt(Chunk *chunk, size_type index, value_type &&value) {
+    value_type *values = chunk->values();
+    Relocate(values + index + 1, values + index, chunk->count - index);
+    try {
+      Construct(values + index, std::move(value));
+    } catch (...) {
+      Relocate(values + index, values + index + 1, chunk->count - index);
+      if (chunk->count == 0) UnlinkAndFree(chunk);
+      throw;
+    }
+    ++chunk->count;
+    ++size_;
+    return iterator(chunk, index);
+  }
+
+  // Destroys every value from pos on and frees the chunks left empty.
+  void Truncate(iterator pos) noexcept {
+    ChunkBase *chunk = pos.chunk_;
+    if (chunk == &header_) return;
+    if (pos.index_ != 0) {
+      DestroyRange(static_cast<Chunk *>(chunk), pos.index_, chunk->count);
+      size_ -= chunk->count - pos.index_;
+      chunk->count = pos.index_;
+      chunk = chunk->next;
+    }
+    while (chunk != &header_) {
+      ChunkBase *next = chunk->next;
+      DestroyRange(static_cast<Chunk *>(chunk), 0, chunk->count);
+      size_ -= chunk->count;
+      chunk->count = 0;
+      UnlinkAndFree(static_cast<Chunk *>(chunk));
+      chunk = next;
+    }
+  }
+
+  void MoveBack(std::vector<value_type> &buffer) {
+    auto from = buffer.begin();
+    for (auto &value : *this) value = std::move(*from++);
+  }
+
+  // Points the end chunks of a header just swapped in back at it.
+  void AdoptChunks(ChunkBase &old_header) noexcept {
+    if (header_.next == &old_header) {
+      header_.prev = header_.next = &header_;
+    } else {
+      header_.next->prev = &header_;
+      header_.prev->next = &header_;
+    }
+  }
+
+  ChunkBase header_{&header_, &header_, 0};
+  size_type size_{0};
+  Allocator alloc_;
+};
+
+}  // namespace s21
+
+#endif  // S21_UNROLLED_LIST_H
@@ -0,0 +1,100 @@
+#ifndef S21_VECTOR_H
+#define S21_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../allocator/s21_aligned_allocator.h"
+#include "../allocator/s21_relocate.h"
+
+namespace s21 {
+
+template <typename T, typename Allocator = std::allocator<T>>
+class vector {
+ public:
+  //  Vector Member type
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+
+  //  Vector Functions
+  vector() noexcept;
+  explicit vector(const Allocator& alloc) noexcept;
+  explicit vector(size_type n);
+  vector(std::initializer_list<value_type> const& items);
+  vector(const vector& v);
+  vector(vector&& v) noexcept;
+  ~vector();
+  vector& operator=(const vector& v);
+  vector& operator=(vector&& v) noexcept;
+
+  // Vector Element access
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+  reference operator[](size_type pos);
+  const_reference operator[](size_type pos) const;
+  reference front();
+  const_reference front() const;
+  reference back();
+  const_reference back() const;
+  T* data() noexcept;
+  const T* data() const noexcept;
+
+  // Vector Iterators
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+  // Vector Capacity
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  void reserve(size_type size);
+  size_type capacity() const noexcept;
+  void shrink_to_fit();
+  allocator_type get_allocator() const;
+
+  // Vector Modifiers
+  void clear() noexcept;
+  iterator insert(iterator pos, const_reference value);
+  iterator insert(iterator pos, value_type&& value);
+  void erase(iterator pos);
+  void push_back(const_reference value);
+  void push_back(value_type&& value);
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
+  void pop_back();
+  void swap(vector& other) noexcept;
+
+ private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  // Support
+  size_type grow_to(size_type needed) const;
+  void reallocate(size_type new_capacity);
+  template <typename... Args>
+  iterator emplace_at(size_type index, Args&&... args);
+  void destroy_range(T* first, T* last) noexcept;
+  void release() noexcept;
+
+  Allocator alloc_;
+  T* data_;
+  size_type size_;
+  size_type capacity_;
+};
+}  // namespace s21
+#include "s21_vector.tpp"
+#endif  // S21_VECTOR_H
@@ -0,0 +1,411 @@
+#ifndef S21_VECTOR_TPP
+#define S21_VECTOR_TPP
+
+#include <algorithm>
+#include <cstring>
+
+#include "s21_vector.h"
+
+namespace s21 {
+//  Vector Functions
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector() noexcept
+    : alloc_(), data_(nullptr), size_(0), capacity_(0) {}
+
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(const Allocator& alloc) noexcept
+    : alloc_(alloc), data_(nullptr), size_(0), capacity_(0) {}
+
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(size_type n)
+    : alloc_(), data_(nullptr), size_(0), capacity_(0) {
+  reserve(n);
+  try {
+    for (; size_ != n; ++size_) {
+      alloc_traits::construct(alloc_, data_ + size_);
+    }
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(
+    std::initializer_list<value_type> const& items)
+    : alloc_(), data_(nullptr), size_(0), capacity_(0) {
+  reserve(items.size());
+  try {
+    for (const auto& item : items) {
+      alloc_traits::construct(alloc_, data_ + size_, item);
+      ++size_;
+    }
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(const vector& v)
+    : alloc_(alloc_traits::select_on_container_copy_construction(v.alloc_)),
+      data_(nullptr),
+      size_(0),
+      capacity_(0) {
+  reserve(v.size_);
+  try {
+    if constexpr (std::is_trivially_copyable_v<value_type>) {
+      if (v.size_ != 0) {
+        std::memcpy(data_, v.data_, v.size_ * sizeof(value_type));
+      }
+      size_ = v.size_;
+    } else {
+      for (; size_ != v.size_; ++size_) {
+        alloc_traits::construct(alloc_, data_ + size_, v.data_[size_]);
+      }
+    }
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(vector&& v) noexcept
+    : alloc_(std::move(v.alloc_)),
+      data_(v.data_),
+      size_(v.size_),
+      capacity_(v.capacity_) {
+  v.data_ = nullptr;
+  v.size_ = 0;
+  v.capacity_ = 0;
+}
+
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::~vector() {
+  release();
+}
+
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>& vector<value_type, Allocator>::operator=(
+    const vector& v) {
+  if (this != &v) {
+    vector copy(v);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>& vector<value_type, Allocator>::operator=(
+    vector&& v) noexcept {
+  if (this != &v) {
+    release();
+    swap(v);
+  }
+  return *this;
+}
+
+// Vector Element access
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::reference
+vector<value_type, Allocator>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return data_[pos];
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::const_reference
+vector<value_type, Allocator>::at(size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return data_[pos];
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::reference
+vector<value_type, Allocator>::operator[](size_type pos) {
+  return data_[pos];
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::const_reference
+vector<value_type, Allocator>::operator[](size_type pos) const {
+  return data_[pos];
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::reference
+vector<value_type, Allocator>::front() {
+  return data_[0];
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::const_reference
+vector<value_type, Allocator>::front() const {
+  return data_[0];
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::reference
+vector<value_type, Allocator>::back() {
+  return data_[size_ - 1];
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::const_reference
+vector<value_type, Allocator>::back() const {
+  return data_[size_ - 1];
+}
+
+template <typename value_type, typename Allocator>
+value_type* vector<value_type, Allocator>::data() noexcept {
+  return data_;
+}
+
+template <typename value_type, typename Allocator>
+const value_type* vector<value_type, Allocator>::data() const noexcept {
+  return data_;
+}
+
+// Vector Iterators
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::iterator
+vector<value_type, Allocator>::begin() noexcept {
+  return data_;
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::iterator
+vector<value_type, Allocator>::end() noexcept {
+  return data_ + size_;
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::const_iterator
+vector<value_type, Allocator>::begin() const noexcept {
+  return data_;
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::const_iterator
+vector<value_type, Allocator>::end() const noexcept {
+  return data_ + size_;
+}
+
+// Vector Capacity
+template <typename value_type, typename Allocator>
+bool vector<value_type, Allocator>::empty() const noexcept {
+  return size_ == 0;
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::size_type
+vector<value_type, Allocator>::size() const noexcept {
+  return size_;
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::size_type
+vector<value_type, Allocator>::max_size() const noexcept {
+  size_type by_diff =
+      std::numeric_limits<difference_type>::max() / sizeof(value_type);
+  size_type by_alloc = alloc_traits::max_size(alloc_);
+  return by_diff < by_alloc ? by_diff : by_alloc;
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::reserve(size_type size) {
+  if (size > max_size()) {
+    throw std::length_error("Limit of the container is exceeded");
+  }
+  if (size > capacity_) {
+    reallocate(size);
+  }
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::size_type
+vector<value_type, Allocator>::capacity() const noexcept {
+  return capacity_;
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::shrink_to_fit() {
+  if (capacity_ > size_) {
+    reallocate(size_);
+  }
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::allocator_type
+vector<value_type, Allocator>::get_allocator() const {
+  return alloc_;
+}
+
+// Vector Modifiers
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::clear() noexcept {
+  destroy_range(data_, data_ + size_);
+  size_ = 0;
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::iterator
+vector<value_type, Allocator>::insert(iterator pos, const_reference value) {
+  return emplace_at(static_cast<size_type>(pos - data_), value);
+}
+
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::iterator
+vector<value_type, Allocator>::insert(iterator pos, value_type&& value) {
+  return emplace_at(static_cast<size_type>(pos - data_), std::move(value));
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::erase(iterator pos) {
+  if (pos < data_ || pos >= data_ + size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  std::move(pos + 1, data_ + size_, pos);
+  --size_;
+  alloc_traits::destroy(alloc_, data_ + size_);
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::push_back(const_reference value) {
+  emplace_back(value);
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::push_back(value_type&& value) {
+  emplace_back(std::move(value));
+}
+
+// The new element is built in the new block before the old ones are
+// relocated, so arguments that refer into this vector stay valid.
+template <typename value_type, typename Allocator>
+template <typename... Args>
+typename vector<value_type, Allocator>::reference
+vector<value_type, Allocator>::emplace_back(Args&&... args) {
+  if (size_ == capacity_) {
+    size_type new_capacity = grow_to(size_ + 1);
+    value_type* block = alloc_traits::allocate(alloc_, new_capacity);
+    try {
+      alloc_traits::construct(alloc_, block + size_,
+                              std::forward<Args>(args)...);
+    } catch (...) {
+      alloc_traits::deallocate(alloc_, block, new_capacity);
+      throw;
+    }
+    try {
+      Relocate(data_, size_, block, alloc_);
+    } catch (...) {
+      alloc_traits::destroy(alloc_, block + size_);
+      alloc_traits::deallocate(alloc_, block, new_capacity);
+      throw;
+    }
+    if (data_) alloc_traits::deallocate(alloc_, data_, capacity_);
+    data_ = block;
+    capacity_ = new_capacity;
+  } else {
+    alloc_traits::construct(alloc_, data_ + size_,
+                            std::forward<Args>(args)...);
+  }
+  return data_[size_++];
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::pop_back() {
+  if (empty()) {
+    throw std::out_of_range("vector is empty");
+  }
+  --size_;
+  alloc_traits::destroy(alloc_, data_ + size_);
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::swap(vector& other) noexcept {
+  using std::swap;
+  swap(alloc_, other.alloc_);
+  swap(data_, other.data_);
+  swap(size_, other.size_);
+  swap(capacity_, other.capacity_);
+}
+
+// Support
+template <typename value_type, typename Allocator>
+typename vector<value_type, Allocator>::size_type
+vector<value_type, Allocator>::grow_to(size_type needed) const {
+  size_type limit = max_size();
+  if (needed > limit) {
+    throw std::length_error("Limit of the container is exceeded");
+  }
+  size_type next = capacity_ < limit / 2 ? capacity_ * 2 : limit;
+  return next < needed ? needed : next;
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::reallocate(size_type new_capacity) {
+  value_type* block = nullptr;
+  if (new_capacity != 0) {
+    block = alloc_traits::allocate(alloc_, new_capacity);
+    try {
+      Relocate(data_, size_, block, alloc_);
+    } catch (...) {
+      alloc_traits::deallocate(alloc_, block, new_capacity);
+      throw;
+    }
+  }
+  if (data_) alloc_traits::deallocate(alloc_, data_, capacity_);
+  data_ = block;
+  capacity_ = new_capacity;
+}
+
+template <typename value_type, typename Allocator>
+template <typename... Args>
+typename vector<value_type, Allocator>::iterator
+vector<value_type, Allocator>::emplace_at(size_type index, Args&&... args) {
+  if (index > size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  if (index == size_) {
+    emplace_back(std::forward<Args>(args)...);
+    return data_ + index;
+  }
+  value_type value(std::forward<Args>(args)...);
+  if (size_ == capacity_) {
+    reallocate(grow_to(size_ + 1));
+  }
+  alloc_traits::construct(alloc_, data_ + size_, std::move(data_[size_ - 1]));
+  ++size_;
+  std::move_backward(data_ + index, data_ + size_ - 2, data_ + size_ - 1);
+  data_[index] = std::move(value);
+  return data_ + index;
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::destroy_range(value_type* first,
+                                                  value_type* last) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<value_type>) {
+    for (; first != last; ++first) {
+      alloc_traits::destroy(alloc_, first);
+    }
+  }
+}
+
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::release() noexcept {
+  destroy_range(data_, data_ + size_);
+  if (data_) alloc_traits::deallocate(alloc_, data_, capacity_);
+  data_ = nullptr;
+  size_ = 0;
+  capacity_ = 0;
+}
+
+}  // namespace s21
+
+#endif  // S21_VECTOR_TPP